@@ -17,7 +17,7 @@ class UE4CONTRIBUTIONCASES_API USomeClassForInstancedProperties : public UObject
 };
 
 UCLASS(EditInlineNew, meta=(DisplayName="First type"))
-class UFirstTypeForInstancing : public USomeClassForInstancedProperties
+class UE4CONTRIBUTIONCASES_API UFirstTypeForInstancing : public USomeClassForInstancedProperties
 {
 public:
 	UPROPERTY(EditDefaultsOnly)
@@ -27,11 +27,25 @@ public:
 };
 
 UCLASS(EditInlineNew, meta=(DisplayName="Second type"))
-class USecondTypeForInstancing : public USomeClassForInstancedProperties
+class UE4CONTRIBUTIONCASES_API USecondTypeForInstancing : public USomeClassForInstancedProperties
 {
 public:
 	UPROPERTY(EditDefaultsOnly)
 	int32 SomeIntValue;
 
+	GENERATED_BODY()
+};
+
+// Chain of instanced objects (round-trip benchmark with "-Depth=")
+UCLASS(EditInlineNew, meta=(DisplayName="Nested type"))
+class UE4CONTRIBUTIONCASES_API UNestedTypeForInstancing : public USomeClassForInstancedProperties
+{
+public:
+	UPROPERTY(EditDefaultsOnly)
+	TArray<float> SomeValues;
+
+	UPROPERTY(EditDefaultsOnly, Instanced)
+	USomeClassForInstancedProperties* NestedObject;
+
 	GENERATED_BODY()
 };
\ No newline at end of file
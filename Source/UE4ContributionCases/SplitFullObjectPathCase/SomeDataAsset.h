@@ -12,7 +12,7 @@
  * 
  */
 USTRUCT()
-struct FSomeStructWithInstancedProperty
+struct UE4CONTRIBUTIONCASES_API FSomeStructWithInstancedProperty
 {
 	UPROPERTY(EditDefaultsOnly, Instanced, NoClear)
 	USomeClassForInstancedProperties* ObjectForInstancing;
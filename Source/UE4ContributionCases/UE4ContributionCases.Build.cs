@@ -12,11 +12,7 @@ public class UE4ContributionCases : ModuleRules
         {
             "Core", 
             "CoreUObject", 
-            "Engine", 
-            "UnrealEd",
-            "InputCore",
-            "ClassViewer",
-            "DesktopPlatform"
+            "Engine"
         });
 
         PrivateDependencyModuleNames.AddRange(new string[] { });
@@ -25,7 +21,7 @@ public class UE4ContributionCases : ModuleRules
         // PrivateDependencyModuleNames.AddRange(new string[] { "Slate", "SlateCore" });
 
         // Uncomment if you are using online features
-        PrivateDependencyModuleNames.AddRange(new string[] {"Json", "JsonUtilities",});
+        // PrivateDependencyModuleNames.AddRange(new string[] { "OnlineSubsystem" });
 
         // To include OnlineSubsystemSteam, add it to the plugins section in your uproject file with the Enabled attribute set to true
     }
@@ -9,6 +9,6 @@ public class UE4ContributionCasesEditorTarget : TargetRules
 	{
 		Type = TargetType.Editor;
 		DefaultBuildSettings = BuildSettingsVersion.V2;
-		ExtraModuleNames.AddRange( new string[] { "UE4ContributionCases" } );
+		ExtraModuleNames.AddRange( new string[] { "UE4ContributionCases", "UE4ContributionCasesEditor" } );
 	}
 }
@@ -0,0 +1,108 @@
+#include "ClassNameIndex.h"
+
+#include "CustomImportCallbackCommandlet.h"
+#include "UObject/UObjectIterator.h"
+
+FClassNameIndex& FClassNameIndex::Get()
+{
+	static FClassNameIndex Instance;
+	return Instance;
+}
+
+FClassNameIndex::FClassNameIndex()
+{
+	// Classes are created with modules and with blueprint packages, replaced on hot-reload and destroyed by GC
+	GUObjectArray.AddUObjectCreateListener(this);
+	FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([this](EReloadCompleteReason)
+	{
+		Invalidate();
+	});
+	FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FClassNameIndex::Invalidate);
+}
+
+void FClassNameIndex::NotifyUObjectCreated(const UObjectBase* Object, int32 Index)
+{
+	// Called for every created object, so only the cast flags of its class are checked
+	if (!bIsOutdated && Object->GetClass()->HasAnyCastFlag(CASTCLASS_UClass))
+		bIsOutdated = true;
+}
+
+void FClassNameIndex::OnUObjectArrayShutdown()
+{
+	GUObjectArray.RemoveUObjectCreateListener(this);
+}
+
+UClass* FClassNameIndex::FindClass(const FString& InShortName)
+{
+	// Name that was never created can't be a class name
+	const FName ShortName(*InShortName, FNAME_Find);
+	return ShortName.IsNone() ? nullptr : FindClass(ShortName);
+}
+
+UClass* FClassNameIndex::FindClass(const FName& InShortName)
+{
+	{
+		FReadScopeLock ReadLock(IndexLock);
+		if (!bIsOutdated)
+			return FindInIndex(InShortName);
+	}
+
+	// One of the threads rebuilds the index, the others wait for it
+	FWriteScopeLock WriteLock(IndexLock);
+	if (bIsOutdated)
+		BuildIndex();
+	return FindInIndex(InShortName);
+}
+
+UClass* FClassNameIndex::FindInIndex(const FName& InShortName) const
+{
+	if (UClass* const* Class = ClassesByName.Find(InShortName))
+		return *Class;
+	if (const FString* ClassPaths = AmbiguousClassPaths.Find(InShortName))
+		UE_LOG(LogDemoJsonCallback, Error, TEXT("Class name '%s' is ambiguous: %s."), *InShortName.ToString(), **ClassPaths);
+	return nullptr;
+}
+
+void FClassNameIndex::Rebuild()
+{
+	FWriteScopeLock WriteLock(IndexLock);
+	BuildIndex();
+}
+
+void FClassNameIndex::Invalidate()
+{
+	bIsOutdated = true;
+}
+
+void FClassNameIndex::BuildIndex()
+{
+	// Classes created while the index is built outdate it again
+	bIsOutdated = false;
+	ClassesByName.Reset();
+	AmbiguousClassPaths.Reset();
+
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		UClass* Class = *It;
+		// Old versions of reinstanced classes and temporary classes are not resolved by name
+		if (Class->HasAnyClassFlags(CLASS_NewerVersionExists) || Class->GetOutermost() == GetTransientPackage())
+			continue;
+
+		const FName ShortName = Class->GetFName();
+		if (FString* ClassPaths = AmbiguousClassPaths.Find(ShortName))
+		{
+			*ClassPaths += TEXT(", ") + Class->GetPathName();
+			continue;
+		}
+
+		UClass* ExistingClass = nullptr;
+		if (ClassesByName.RemoveAndCopyValue(ShortName, ExistingClass))
+		{
+			AmbiguousClassPaths.Add(ShortName, ExistingClass->GetPathName() + TEXT(", ") + Class->GetPathName());
+			continue;
+		}
+		ClassesByName.Add(ShortName, Class);
+	}
+
+	UE_LOG(LogDemoJsonCallback, Verbose, TEXT("Class name index: %d classes, %d ambiguous names."), ClassesByName.Num(), AmbiguousClassPaths.Num());
+}
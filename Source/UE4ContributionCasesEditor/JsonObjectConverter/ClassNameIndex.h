@@ -0,0 +1,46 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/UObjectArray.h"
+
+/**
+ * Index of the loaded classes by short name, replacement of FindObject<UClass>(ANY_PACKAGE, ...) in the import paths.
+ * Thread-safe (batch import resolves classes from worker threads). The index is outdated when a class is created
+ * (module load, blueprint class of a loaded package), after GC and after hot-reload, and it is rebuilt by the next lookup,
+ * so a name which is not in the up to date index is a miss without any search. Short names shared by several classes
+ * are ambiguous and are not resolved.
+ */
+class FClassNameIndex : public FUObjectArray::FUObjectCreateListener
+{
+public:
+	static FClassNameIndex& Get();
+
+	// Class by its short name ("SomeDataAsset"). Logs an error and returns nullptr if the name is ambiguous
+	UClass* FindClass(const FString& InShortName);
+	UClass* FindClass(const FName& InShortName);
+
+	// Build the index from the currently loaded classes (call on the game thread before a large import)
+	void Rebuild();
+
+	// The index is rebuilt by the next lookup
+	void Invalidate();
+
+	// FUObjectCreateListener
+	virtual void NotifyUObjectCreated(const UObjectBase* Object, int32 Index) override;
+	virtual void OnUObjectArrayShutdown() override;
+
+private:
+	FClassNameIndex();
+
+	void BuildIndex();
+	UClass* FindInIndex(const FName& InShortName) const;
+
+	FRWLock IndexLock;
+	TAtomic<bool> bIsOutdated { true };
+	// Raw pointers are valid: the index is outdated after each GC
+	TMap<FName, UClass*> ClassesByName;
+	// Short name => path names of all classes with this name
+	TMap<FName, FString> AmbiguousClassPaths;
+};
@@ -0,0 +1,1657 @@
+﻿#include "CustomImportCallbackCommandlet.h"
+
+#include "ClassNameIndex.h"
+#include "CustomJsonCallbacks.h"
+#include "ExportManifest.h"
+#include "FileHelpers.h"
+#include "JsonArenaDocument.h"
+#include "JsonAssetBundle.h"
+#include "JsonBinaryFormat.h"
+#include "JsonConverterStats.h"
+#include "JsonImportValidator.h"
+#include "JsonLinkerExport.h"
+#include "JsonObjectGraph.h"
+#include "JsonObjectConverter.h"
+#include "JsonPropertyStreamReader.h"
+#include "JsonPropertyStreamWriter.h"
+#include "JsonReferenceTable.h"
+#include "JsonTypedSerializers.h"
+#include "ObjectExportPathCache.h"
+#include "ObjectImportReferenceCache.h"
+#include "PackageTools.h"
+#include "PropertySchemaCache.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Dom/JsonObject.h"
+#include "Misc/FileHelper.h"
+#include "Misc/ScopeExit.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "UE4ContributionCasesEditor/SplitFullObjectPathCase/ObjectPathSplitter.h"
+#include "UE4ContributionCases/SplitFullObjectPathCase/SomeDataAsset.h"
+#include "UObject/ConstructorHelpers.h"
+
+UCustomImportCallbackCommandlet::UCustomImportCallbackCommandlet(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	LogToConsole = true;
+}
+
+int32 UCustomImportCallbackCommandlet::Main(const FString& Params)
+{
+	UE_LOG(LogDemoJsonCallback, Display, TEXT("UCustomImportCallbackCommandlet::Main => Params: '%s'"), *Params);
+
+	bLogPayload = !FParse::Param(*Params, TEXT("NoLogPayload"));
+	FParse::Value(*Params, TEXT("LogPayloadLimit="), MaxLoggedPayloadLen);
+	bInternReferences = FParse::Param(*Params, TEXT("InternRefs"));
+	bObjectGraph = FParse::Param(*Params, TEXT("ObjectGraph"));
+	bLinkerExport = FParse::Param(*Params, TEXT("LinkerExport"));
+	// Ids of the object graph are given to the loaded objects
+	if (bLinkerExport && bObjectGraph)
+	{
+		UE_LOG(LogDemoJsonCallback, Warning, TEXT("-LinkerExport is not supported with -ObjectGraph. The assets are loaded."));
+		bLinkerExport = false;
+	}
+	// Only the properties different from the CDO/archetype are exported
+	FCustomCallbacksDemoLocal::SetExportDelta(FParse::Param(*Params, TEXT("Delta")));
+	// Reflection-free serializers of the registered types (see JsonTypedSerializers.h)
+	FJsonTypedSerializerRegistry::Get().SetEnabled(FParse::Param(*Params, TEXT("TypedSerializers")));
+
+	// Performance report of the run (whatever mode returns)
+	FString Mode = TEXT("Demo");
+	FJsonConverterStats::Get().Reset();
+	ON_SCOPE_EXIT
+	{
+		ReportStats(Params, Mode);
+	};
+
+	// Bulk mode: export of assets resolved through the asset registry instead of the single demo asset
+	FString PathsFilter;
+	FString ClassFilter;
+	if (FParse::Value(*Params, TEXT("Paths="), PathsFilter, false) || FParse::Value(*Params, TEXT("Class="), ClassFilter))
+	{
+		Mode = TEXT("BulkExport");
+		return BulkExportCase(Params);
+	}
+
+	FString ImportSource;
+	if (FParse::Value(*Params, TEXT("ImportDir="), ImportSource) || FParse::Value(*Params, TEXT("ImportFile="), ImportSource) || FParse::Value(*Params, TEXT("ImportBundle="), ImportSource))
+	{
+		Mode = FParse::Param(*Params, TEXT("Validate")) ? TEXT("Validate") : TEXT("BatchImport");
+		return BatchImportCase(Params);
+	}
+
+	FString ConvertInput;
+	if (FParse::Value(*Params, TEXT("ConvertToBinary="), ConvertInput) || FParse::Value(*Params, TEXT("ConvertToJson="), ConvertInput) || FParse::Value(*Params, TEXT("ConvertToBundle="), ConvertInput))
+	{
+		Mode = TEXT("Convert");
+		return ConvertCase(Params);
+	}
+
+	// Interchange format of the demo steps: "-Format=Json" (default) or "-Format=Binary"
+	FString Format;
+	FParse::Value(*Params, TEXT("Format="), Format);
+	const bool bBinaryFormat = Format.Equals(TEXT("Binary"), ESearchCase::IgnoreCase);
+	
+	// To demonstrate a specific case, export to json and import from json are well reproduced,
+	// the reference of this specific date asset:
+	// SomeDataAsset'/Game/ExamplesAssets/CustomDataAssets/DA_SomeDataAsset.DA_SomeDataAsset'
+	const FString ReferenceString("SomeDataAsset'/Game/ExamplesAssets/CustomDataAssets/DA_SomeDataAsset.DA_SomeDataAsset'");
+		
+	// Save exported custom data into "%ProjectSavedDir%/CustomExportData.json" file as example  
+	const FString OutputFilePath(FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("CustomExportData")) + (bBinaryFormat ? FJsonBinaryFormat::FileExtension : TEXT(".json")));
+
+	// Step 1
+	// Demo for CustomExportCallback
+	{
+		UE_LOG(LogDemoJsonCallback, Display, TEXT("UCustomImportCallbackCommandlet::Main => Step 1: Export DA_SomeDataAsset to CustomExportData.json using FJsonObjectConverter::CustomExportCallback."));
+		if (bBinaryFormat)
+		{
+			const TSharedPtr<FJsonObject> OutputJson = ExportCase(ReferenceString);
+			if (bInternReferences)
+				FJsonReferenceTable::InternReferences(OutputJson.ToSharedRef());
+			if (!FJsonBinaryFormat::SaveToFile(MakeShared<FJsonValueObject>(OutputJson), OutputFilePath))
+				UE_LOG(LogDemoJsonCallback, Fatal, TEXT("Unable to save file '%s'."), *OutputFilePath);
+			JSON_CONVERTER_COUNT(BytesWritten, IFileManager::Get().FileSize(*OutputFilePath));
+		}
+		else if (FParse::Param(*Params, TEXT("Streaming")))
+		{
+			// The same json, but without the intermediate FJsonObject tree and FString copies
+			if (bInternReferences)
+				UE_LOG(LogDemoJsonCallback, Warning, TEXT("-InternRefs is not supported by the streaming export."));
+			if (bObjectGraph)
+				UE_LOG(LogDemoJsonCallback, Warning, TEXT("-ObjectGraph is not supported by the streaming export."));
+			if (FCustomCallbacksDemoLocal::IsExportDelta())
+				UE_LOG(LogDemoJsonCallback, Warning, TEXT("-Delta is not supported by the streaming export."));
+			if (bLinkerExport)
+				UE_LOG(LogDemoJsonCallback, Warning, TEXT("-LinkerExport is not supported by the streaming export."));
+			StreamExportCase(ReferenceString, OutputFilePath);
+		}
+		else
+		{
+			const TSharedPtr<FJsonObject> OutputJson = ExportCase(ReferenceString);
+			if (bInternReferences)
+				FJsonReferenceTable::InternReferences(OutputJson.ToSharedRef());
+			// Save to temp file
+			SaveToJsonFile(OutputJson, OutputFilePath);
+		}
+	}
+
+	// Step 2
+	// Rewrite the instanced subobject from the property in DA_SomeDataAsset to demonstrate
+	// that the current implementation of function FJsonObjectConverter::JsonValueToUProperty (which is used in the ImportCase function)
+	// inside the engine does not work as expected without adding CustomImportCallback
+	{
+		UE_LOG(LogDemoJsonCallback, Display, TEXT("UCustomImportCallbackCommandlet::Main => Step 2: Rewrite the instanced subobject from the property in DA_SomeDataAsset to demonstrate."));
+		// Load object
+		FString ObjectPath = ReferenceString;
+		ConstructorHelpers::StripObjectClass(ObjectPath);
+		USomeDataAsset* SomeDataAsset = LoadObject<USomeDataAsset>(nullptr, *ObjectPath);
+		if (!SomeDataAsset)
+			UE_LOG(LogDemoJsonCallback, Fatal, TEXT("Unable to load object '%s'."), *ObjectPath);
+		// Change property data 
+		SomeDataAsset->ArrayStructWithInstancedObject = TArray<FSomeStructWithInstancedProperty>();
+		// Save changed DataAsset
+		if (!UEditorLoadingAndSavingUtils::SavePackages({UPackageTools::LoadPackage(ObjectPath)}, false))
+			UE_LOG(LogDemoJsonCallback, Fatal, TEXT("Unable to save package %s."), *ObjectPath)
+		UE_LOG(LogDemoJsonCallback, Display, TEXT("UCustomImportCallbackCommandlet::Main => Property 'ArrayStructWithInstancedObject' rewrited on empty Array."));
+
+		// Print to console current Asset data
+		UE_LOG(LogDemoJsonCallback, Display, TEXT("UCustomImportCallbackCommandlet::Main => After changed property and save package, DataAsset content:"));
+		const TSharedPtr<FJsonObject> ChangedJson = ExportCase(ReferenceString);
+		SerializeJson(ChangedJson);
+	}
+
+	// Step 3
+	// Demonstration of the need CustomImportCallback
+	// NOTE: I am surprised that there is such a callback in the FJsonObjectConverter::UPropertyToJsonValue function,
+	// but in the case of FJsonObjectConverter::JsonValueToUProperty, there is no way to set it.
+	// I suggest to introduce this functionality. I am preparing a pull request into engine
+	{
+		UE_LOG(LogDemoJsonCallback, Display, TEXT("UCustomImportCallbackCommandlet::Main => Step 3: Let's try to recover the DA_SomeDataAsset from the CustomExportData.json file"));
+		// Binary file is detected by LoadJsonFile inside ImportCase
+		if (FParse::Param(*Params, TEXT("Streaming")) && !bBinaryFormat)
+			StreamImportCase(ReferenceString, OutputFilePath);
+		else
+			ImportCase(ReferenceString, OutputFilePath);
+
+		// Print to console current Asset data
+		UE_LOG(LogDemoJsonCallback, Display, TEXT("UCustomImportCallbackCommandlet::Main => After import (an attempt to restore the original data)."));
+		const TSharedPtr<FJsonObject> AfterImportJson = ExportCase(ReferenceString);
+		SerializeJson(AfterImportJson);
+	}
+
+	// Summary:
+	// Without the ability to define my CustomImportCallback, I still have to write additional code, otherwise, I will lose some of the data in the properties that are marked as instantiated.
+    // If CustomImportCallback is in the engine code - this situation can be avoided and successfully restore all properties of the object.
+    // I will prepare a pull request to the engine code with this functionality.
+	
+	return 0;
+}
+
+TSharedPtr<FJsonObject> UCustomImportCallbackCommandlet::ExportCase(const FString& InReferenceString)
+{
+	using namespace FCustomCallbacksDemoLocal;
+	
+	UE_LOG(LogDemoJsonCallback, Display, TEXT("--- Demo for FJsonObjectConverter::CustomExportCallback started ---"));
+	JSON_CONVERTER_TIMER_SCOPE(Export);
+
+	// Make a JsonObject to collect textual representation of object property values
+	TSharedRef<FJsonObject> JsonAssetObject = MakeShared<FJsonObject>();
+	// Get asset package
+	FString PackagePath = InReferenceString;
+	ConstructorHelpers::StripObjectClass(PackagePath);
+	
+	// Check package exist
+	FString OutPackageFileName;
+	const bool bIsExist = FPackageName::DoesPackageExist(*PackagePath, nullptr, &OutPackageFileName);
+	if (!bIsExist)
+		UE_LOG(LogDemoJsonCallback, Fatal, TEXT("Package '%s' does not exist"), *PackagePath);
+
+	// Properties are read from the package file, the object is loaded only if some of them need it
+	if (bLinkerExport)
+	{
+		const FJsonLinkerExport::EResult Result = FJsonLinkerExport::ExportObject(PackagePath, JsonAssetObject);
+		if (Result != FJsonLinkerExport::EResult::NotSupported)
+		{
+			UE_LOG(LogDemoJsonCallback, Display, TEXT("--- Demo for FJsonObjectConverter::CustomExportCallback succesfull finished (%s) ---"),
+				Result == FJsonLinkerExport::EResult::Exported ? TEXT("read from the package file") : TEXT("read from the package file, partially loaded"));
+			return JsonAssetObject;
+		}
+		JsonAssetObject->Values.Empty();
+	}
+
+	// Load object by path 
+	UObject* Object = LoadObject<UObject>(nullptr, *PackagePath);
+	if (!Object)
+		UE_LOG(LogDemoJsonCallback, Fatal, TEXT("Unable to load object '%s'."), *PackagePath);
+
+	// Iterate by properties and collect it into JsonObject
+	if (bObjectGraph)
+		FJsonObjectGraph::ExportObject(Object, JsonAssetObject);
+	else
+		ExportObjectProperties(Object, JsonAssetObject);
+
+	UE_LOG(LogDemoJsonCallback, Display, TEXT("--- Demo for FJsonObjectConverter::CustomExportCallback succesfull finished ---"));
+	return JsonAssetObject;	
+}
+
+void UCustomImportCallbackCommandlet::ImportCase(const FString& InReferenceString, const FString& InOpenFilePath)
+{
+	using namespace FCustomCallbacksDemoLocal;
+	
+	UE_LOG(LogDemoJsonCallback, Display, TEXT("--- Demo for FJsonObjectConverter::CustomImportCallback started ---"));
+	JSON_CONVERTER_TIMER_SCOPE(Import);
+
+	// Get asset package
+	FString PackagePath = InReferenceString;
+	ConstructorHelpers::StripObjectClass(PackagePath);
+	
+	// Check package exist
+	FString OutPackageFileName;
+	const bool bIsExist = FPackageName::DoesPackageExist(*PackagePath, nullptr, &OutPackageFileName);
+	if (!bIsExist)
+		UE_LOG(LogDemoJsonCallback, Fatal, TEXT("Package '%s' does not exist"), *PackagePath);
+
+	// Load object by path 
+	UObject* Object = LoadObject<UObject>(nullptr, *PackagePath);
+	if (!Object)
+		UE_LOG(LogDemoJsonCallback, Fatal, TEXT("Unable to load object '%s'."), *PackagePath);
+
+	// Load data from json file
+	TSharedPtr<FJsonValue> JsonFile = LoadJsonFile(InOpenFilePath);
+	TSharedPtr<FJsonObject> const* JsonObjectContent;
+	if (!JsonFile->TryGetObject(JsonObjectContent))
+		UE_LOG(LogDemoJsonCallback, Fatal, TEXT("Unexpected file content '%s'."), *InOpenFilePath);
+
+	// Parse properties
+	if (!ImportObjectProperties(Object, JsonObjectContent->ToSharedRef()))
+		UE_LOG(LogDemoJsonCallback, Fatal, TEXT("Unexpected properties in file '%s' for class %s."), *InOpenFilePath, *Object->GetClass()->GetName());
+
+	// Save changed DataAsset
+	{
+		JSON_CONVERTER_TIMER_SCOPE(SavePackages);
+		if (!UEditorLoadingAndSavingUtils::SavePackages({UPackageTools::LoadPackage(PackagePath)}, false))
+			UE_LOG(LogDemoJsonCallback, Fatal, TEXT("Unable to save package %s."), *PackagePath)
+	}
+	
+	UE_LOG(LogDemoJsonCallback, Display, TEXT("Succesful save DA_SomeDataAsset after importing data from json file"));
+	
+	UE_LOG(LogDemoJsonCallback, Display, TEXT("--- Demo for FJsonObjectConverter::CustomImportCallback succesfull finished ---"));
+}
+
+void UCustomImportCallbackCommandlet::StreamImportCase(const FString& InReferenceString, const FString& InOpenFilePath)
+{
+	UE_LOG(LogDemoJsonCallback, Display, TEXT("--- Streaming import started ---"));
+	JSON_CONVERTER_TIMER_SCOPE(Import);
+
+	// Get asset package
+	FString PackagePath = InReferenceString;
+	ConstructorHelpers::StripObjectClass(PackagePath);
+
+	// Load object by path 
+	UObject* Object = LoadObject<UObject>(nullptr, *PackagePath);
+	if (!Object)
+		UE_LOG(LogDemoJsonCallback, Fatal, TEXT("Unable to load object '%s'."), *PackagePath);
+
+	// Json tokens are read from the file and written into the properties one by one
+	TUniquePtr<FArchive> FileReader(IFileManager::Get().CreateFileReader(*InOpenFilePath));
+	if (!FileReader)
+		UE_LOG(LogDemoJsonCallback, Fatal, TEXT("Unable to open file '%s'."), *InOpenFilePath);
+
+	JSON_CONVERTER_COUNT(BytesRead, FileReader->TotalSize());
+
+	FJsonPropertyStreamReader JsonReader(FileReader.Get());
+	if (!JsonReader.ReadObject(Object))
+		UE_LOG(LogDemoJsonCallback, Fatal, TEXT("Unable to import file '%s': %s"), *InOpenFilePath, *JsonReader.GetErrorMessage());
+
+	// Save changed DataAsset
+	{
+		JSON_CONVERTER_TIMER_SCOPE(SavePackages);
+		if (!UEditorLoadingAndSavingUtils::SavePackages({UPackageTools::LoadPackage(PackagePath)}, false))
+			UE_LOG(LogDemoJsonCallback, Fatal, TEXT("Unable to save package %s."), *PackagePath)
+	}
+
+	UE_LOG(LogDemoJsonCallback, Display, TEXT("--- Streaming import succesfull finished ---"));
+}
+
+int32 UCustomImportCallbackCommandlet::BulkExportCase(const FString& Params)
+{
+	using namespace FCustomCallbacksDemoLocal;
+
+	UE_LOG(LogDemoJsonCallback, Display, TEXT("--- Bulk export started ---"));
+
+	// Parse filter and output settings
+	FString PathsValue;
+	FParse::Value(*Params, TEXT("Paths="), PathsValue, false);
+	TArray<FString> Paths;
+	PathsValue.ParseIntoArray(Paths, TEXT(","));
+
+	FString ClassValue;
+	FParse::Value(*Params, TEXT("Class="), ClassValue);
+
+	// Single file: newline-delimited json stream or bundle with the index
+	FString OutputFile;
+	const bool bBundle = FParse::Value(*Params, TEXT("OutputBundle="), OutputFile);
+	const bool bSingleStream = bBundle || FParse::Value(*Params, TEXT("OutputFile="), OutputFile);
+
+	FString OutputDir = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("BulkExport"));
+	FParse::Value(*Params, TEXT("OutputDir="), OutputDir);
+
+	// Format of separate files: "-Format=Json" (default) or "-Format=Binary"
+	FString Format;
+	FParse::Value(*Params, TEXT("Format="), Format);
+	const bool bBinaryFormat = Format.Equals(TEXT("Binary"), ESearchCase::IgnoreCase);
+
+	// Number of assets loaded at once (between the batches loaded objects are released by GC)
+	int32 BatchSize = 256;
+	FParse::Value(*Params, TEXT("BatchSize="), BatchSize);
+	BatchSize = FMath::Max(BatchSize, 1);
+
+	// Number of packages loaded asynchronously at once, 0 - synchronous loading
+	int32 AsyncDepth = 0;
+	FParse::Value(*Params, TEXT("AsyncDepth="), AsyncDepth);
+	if (bLinkerExport && AsyncDepth > 0)
+	{
+		UE_LOG(LogDemoJsonCallback, Warning, TEXT("-AsyncDepth is not used with -LinkerExport: package files are read on the game thread."));
+		AsyncDepth = 0;
+	}
+
+	// Resolve assets through the asset registry
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	if (Paths.Num() > 0)
+		AssetRegistry.ScanPathsSynchronous(Paths);
+	else
+		AssetRegistry.SearchAllAssets(true);
+
+	FARFilter Filter;
+	for (const FString& Path : Paths)
+		Filter.PackagePaths.Add(FName(*Path));
+	if (!ClassValue.IsEmpty())
+		Filter.ClassNames.Add(FName(*ClassValue));
+	Filter.bRecursivePaths = true;
+	Filter.bRecursiveClasses = true;
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssets(Filter, Assets);
+	UE_LOG(LogDemoJsonCallback, Display, TEXT("Found %d assets for Paths='%s' Class='%s'."), Assets.Num(), *PathsValue, *ClassValue);
+
+	// Incremental export: packages with unchanged source file and class schema are skipped without loading
+	bool bIncremental = FParse::Param(*Params, TEXT("Incremental"));
+	if (bIncremental && bSingleStream)
+	{
+		UE_LOG(LogDemoJsonCallback, Warning, TEXT("-Incremental is supported only for separate files (-OutputDir). Full export into '%s'."), *OutputFile);
+		bIncremental = false;
+	}
+
+	FString ManifestFile = FExportManifest::GetDefaultFilePath();
+	FParse::Value(*Params, TEXT("Manifest="), ManifestFile);
+
+	FExportManifest Manifest;
+	TArray<FExportManifest::FEntry> ManifestEntries;
+	if (bIncremental)
+	{
+		// Options which change the output: the files exported with the other options are not up to date
+		const FString ExportOptions = FString::Printf(TEXT("Delta=%d,InternRefs=%d,ObjectGraph=%d,TypedSerializers=%d,LinkerExport=%d"),
+			IsExportDelta(), bInternReferences, bObjectGraph, FJsonTypedSerializerRegistry::Get().IsEnabled(), bLinkerExport);
+		if (!Manifest.Load(ManifestFile, ExportOptions))
+			UE_LOG(LogDemoJsonCallback, Display, TEXT("Manifest '%s' not found or outdated. All assets will be exported."), *ManifestFile);
+
+		// Packages removed since the previous export: their entries and output files are removed as well
+		const int32 NumRemoved = Manifest.PruneRemovedPackages();
+		if (NumRemoved > 0)
+			UE_LOG(LogDemoJsonCallback, Display, TEXT("Incremental export: %d removed packages pruned from the manifest and the output."), NumRemoved);
+
+		// Source file hash by content is more expensive, but doesn't depend on timestamps (e.g. after VCS sync)
+		const bool bHashSourceContent = FParse::Param(*Params, TEXT("HashSources"));
+
+		TArray<FAssetData> OutdatedAssets;
+		for (const FAssetData& AssetData : Assets)
+		{
+			FExportManifest::FEntry Entry;
+			const UClass* AssetClass = FClassNameIndex::Get().FindClass(AssetData.AssetClass);
+			const bool bHasEntry = Manifest.MakeEntry(AssetData.PackageName, AssetClass, bHashSourceContent, Entry);
+			Entry.OutputFile = FPaths::Combine(OutputDir, AssetData.PackageName.ToString().Mid(1) + (bBinaryFormat ? FJsonBinaryFormat::FileExtension : TEXT(".json")));
+			if (bHasEntry && !Manifest.IsOutdated(AssetData.PackageName, Entry))
+				continue;
+
+			OutdatedAssets.Add(AssetData);
+			// Entry without source state is never up to date, so it is not stored
+			ManifestEntries.Add(bHasEntry ? Entry : FExportManifest::FEntry());
+		}
+
+		UE_LOG(LogDemoJsonCallback, Display, TEXT("Incremental export: %d assets are up to date, %d assets to export."), Assets.Num() - OutdatedAssets.Num(), OutdatedAssets.Num());
+		Assets = MoveTemp(OutdatedAssets);
+	}
+
+	TUniquePtr<FArchive> StreamWriter;
+	if (bSingleStream)
+	{
+		StreamWriter.Reset(IFileManager::Get().CreateFileWriter(*OutputFile));
+		if (!StreamWriter)
+			UE_LOG(LogDemoJsonCallback, Fatal, TEXT("Unable to create file '%s'."), *OutputFile);
+	}
+	TUniquePtr<FJsonAssetBundleWriter> BundleWriter;
+	if (bBundle)
+		BundleWriter = MakeUnique<FJsonAssetBundleWriter>(StreamWriter.Get());
+
+	int32 NumExported = 0;
+	int32 NumLinkerExported = 0;
+	int32 NumLinkerPartiallyLoaded = 0;
+	for (int32 BatchStart = 0; BatchStart < Assets.Num(); BatchStart += BatchSize)
+	{
+		const int32 BatchNum = FMath::Min(BatchSize, Assets.Num() - BatchStart);
+
+		TArray<UObject*> Objects;
+		Objects.SetNumZeroed(BatchNum);
+		// Records read from the package files ("-LinkerExport"), the assets of these records are not loaded
+		TArray<TSharedPtr<FJsonObject>> LinkerRecords;
+		LinkerRecords.SetNum(BatchNum);
+
+		// Conversion of the loaded objects runs on worker threads. GC runs only after all conversions of the batch are finished
+		TArray<FString> SerializedJsons;
+		SerializedJsons.SetNum(BatchNum);
+		TArray<FString> OutputHashes;
+		OutputHashes.SetNum(BatchNum);
+		TArray<FString> OutputStates;
+		OutputStates.SetNum(BatchNum);
+		// Errors of the workers are reported on the game thread, in the order of the assets
+		TArray<FString> ExportErrors;
+		ExportErrors.SetNum(BatchNum);
+		auto ExportAsset = [&](int32 Index)
+		{
+			const UObject* Object = Objects[Index];
+			if (!Object && !LinkerRecords[Index])
+				return;
+
+			JSON_CONVERTER_TIMER_SCOPE(Export);
+
+			const FAssetData& AssetData = Assets[BatchStart + Index];
+			auto MakeAssetRecord = [&]() -> TSharedRef<FJsonObject>
+			{
+				if (LinkerRecords[Index])
+					return LinkerRecords[Index].ToSharedRef();
+
+				TSharedRef<FJsonObject> JsonAssetObject = MakeShared<FJsonObject>();
+				JsonAssetObject->SetStringField(AssetRefPropertyName, AssetData.GetExportTextName());
+				if (bObjectGraph)
+					FJsonObjectGraph::ExportObject(Object, JsonAssetObject);
+				else
+					ExportObjectProperties(Object, JsonAssetObject);
+				return JsonAssetObject;
+			};
+
+			if (bSingleStream)
+			{
+				TSharedRef<FJsonObject> JsonAssetObject = MakeAssetRecord();
+				// The table is written per record, so records stay independent (bundle import reads them separately)
+				if (bInternReferences)
+					FJsonReferenceTable::InternReferences(JsonAssetObject);
+				SerializedJsons[Index] = SerializeJsonCondensed(JsonAssetObject);
+				return;
+			}
+
+			const FString SaveFilePath = FPaths::Combine(OutputDir, AssetData.PackageName.ToString().Mid(1) + (bBinaryFormat ? FJsonBinaryFormat::FileExtension : TEXT(".json")));
+			if (bBinaryFormat || bInternReferences || bObjectGraph || IsExportDelta() || LinkerRecords[Index])
+			{
+				TSharedRef<FJsonObject> JsonAssetObject = MakeAssetRecord();
+				if (bInternReferences)
+					FJsonReferenceTable::InternReferences(JsonAssetObject);
+
+				const bool bSaved = bBinaryFormat
+					? FJsonBinaryFormat::SaveToFile(MakeShared<FJsonValueObject>(JsonAssetObject), SaveFilePath)
+					: FFileHelper::SaveStringToFile(SerializeJsonCondensed(JsonAssetObject), *SaveFilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+				if (!bSaved)
+				{
+					ExportErrors[Index] = FString::Printf(TEXT("Unable to save file '%s'."), *SaveFilePath);
+					return;
+				}
+				JSON_CONVERTER_COUNT(BytesWritten, IFileManager::Get().FileSize(*SaveFilePath));
+			}
+			else
+			{
+				// One file per asset is written by the streaming writer, without json tree
+				TUniquePtr<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*SaveFilePath));
+				if (!FileWriter)
+				{
+					ExportErrors[Index] = FString::Printf(TEXT("Unable to save file '%s'."), *SaveFilePath);
+					return;
+				}
+				FJsonPropertyStreamWriter JsonWriter(FileWriter.Get());
+				JsonWriter.WriteObject(Object, AssetData.GetExportTextName());
+				if (!JsonWriter.Close() || !FileWriter->Close())
+				{
+					ExportErrors[Index] = FString::Printf(TEXT("Unable to save file '%s'."), *SaveFilePath);
+					return;
+				}
+				if (!JsonWriter.GetErrorMessage().IsEmpty())
+				{
+					ExportErrors[Index] = JsonWriter.GetErrorMessage();
+					return;
+				}
+				JSON_CONVERTER_COUNT(BytesWritten, FileWriter->TotalSize());
+			}
+
+			if (bIncremental)
+			{
+				OutputHashes[Index] = LexToString(FMD5Hash::HashFile(*SaveFilePath));
+				OutputStates[Index] = FExportManifest::GetFileState(SaveFilePath);
+			}
+		};
+
+		if (AsyncDepth > 0)
+		{
+			// Pipelined loading: up to AsyncDepth packages are requested at once and each object is converted by a task
+			// as soon as its package is loaded. The game thread keeps ticking the async loading while the tasks run,
+			// so the reads of the next packages overlap with the conversion
+			TArray<TFuture<void>> Conversions;
+			int32 NextRequest = 0;
+			int32 NumInFlight = 0;
+			while (NextRequest < BatchNum || NumInFlight > 0)
+			{
+				for (; NumInFlight < AsyncDepth && NextRequest < BatchNum; ++NextRequest, ++NumInFlight)
+				{
+					const int32 Index = NextRequest;
+					LoadPackageAsync(Assets[BatchStart + Index].PackageName.ToString(), FLoadPackageAsyncDelegate::CreateLambda(
+						[&, Index](const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result)
+						{
+							// Completion callbacks are called on the game thread from ProcessAsyncLoading
+							--NumInFlight;
+							if (Result == EAsyncLoadingResult::Succeeded && LoadedPackage)
+								Objects[Index] = StaticFindObjectFast(UObject::StaticClass(), LoadedPackage, Assets[BatchStart + Index].AssetName);
+
+							if (Objects[Index])
+								Conversions.Add(Async(EAsyncExecution::TaskGraph, [&ExportAsset, Index]() { ExportAsset(Index); }));
+							else
+								UE_LOG(LogDemoJsonCallback, Error, TEXT("Unable to load object '%s'. Asset skipped."), *Assets[BatchStart + Index].ObjectPath.ToString());
+						}));
+				}
+
+				ProcessAsyncLoading(true, false, 0.005f);
+			}
+
+			// All conversions of the batch are finished before the output and the GC
+			for (TFuture<void>& Conversion : Conversions)
+				Conversion.Wait();
+		}
+		else
+		{
+			// Loading stays on the game thread
+			for (int32 Index = 0; Index < BatchNum; ++Index)
+			{
+				// Linker export: the package file is read without loading the asset, only the conversion to text is left for the workers
+				if (bLinkerExport)
+				{
+					JSON_CONVERTER_TIMER_SCOPE(LoadFile);
+					const FAssetData& AssetData = Assets[BatchStart + Index];
+					TSharedRef<FJsonObject> JsonAssetObject = MakeShared<FJsonObject>();
+					JsonAssetObject->SetStringField(AssetRefPropertyName, AssetData.GetExportTextName());
+					const FJsonLinkerExport::EResult Result = FJsonLinkerExport::ExportObject(AssetData.ObjectPath.ToString(), JsonAssetObject);
+					if (Result != FJsonLinkerExport::EResult::NotSupported)
+					{
+						LinkerRecords[Index] = JsonAssetObject;
+						++NumLinkerExported;
+						NumLinkerPartiallyLoaded += Result == FJsonLinkerExport::EResult::ExportedWithLoad ? 1 : 0;
+						continue;
+					}
+				}
+
+				Objects[Index] = Assets[BatchStart + Index].GetAsset();
+				if (!Objects[Index])
+					UE_LOG(LogDemoJsonCallback, Error, TEXT("Unable to load object '%s'. Asset skipped."), *Assets[BatchStart + Index].ObjectPath.ToString());
+			}
+			ParallelFor(BatchNum, ExportAsset);
+		}
+
+		// Keep the order of the asset registry in the stream
+		for (int32 Index = 0; Index < BatchNum; ++Index)
+		{
+			if (!Objects[Index] && !LinkerRecords[Index])
+				continue;
+			if (!ExportErrors[Index].IsEmpty())
+			{
+				UE_LOG(LogDemoJsonCallback, Error, TEXT("Asset '%s' skipped: %s"), *Assets[BatchStart + Index].ObjectPath.ToString(), *ExportErrors[Index]);
+				continue;
+			}
+
+			if (BundleWriter)
+			{
+				if (!BundleWriter->AddRecord(Assets[BatchStart + Index].GetExportTextName(), SerializedJsons[Index]))
+				{
+					UE_LOG(LogDemoJsonCallback, Error, TEXT("Asset '%s' skipped: duplicate record in the bundle."), *Assets[BatchStart + Index].ObjectPath.ToString());
+					continue;
+				}
+			}
+			else if (StreamWriter)
+			{
+				FTCHARToUTF8 Utf8Line(*(SerializedJsons[Index] + TEXT("\n")));
+				StreamWriter->Serialize(const_cast<ANSICHAR*>(Utf8Line.Get()), Utf8Line.Length());
+				JSON_CONVERTER_COUNT(BytesWritten, Utf8Line.Length());
+			}
+
+			// Only successfully written files are up to date in the manifest
+			if (bIncremental && !OutputHashes[Index].IsEmpty() && !ManifestEntries[BatchStart + Index].SourceHash.IsEmpty())
+			{
+				FExportManifest::FEntry& Entry = ManifestEntries[BatchStart + Index];
+				Entry.OutputHash = OutputHashes[Index];
+				Entry.OutputState = OutputStates[Index];
+				Manifest.SetEntry(Assets[BatchStart + Index].PackageName, Entry);
+			}
+			++NumExported;
+		}
+
+		UE_LOG(LogDemoJsonCallback, Display, TEXT("Exported %d/%d assets."), NumExported, Assets.Num());
+
+		// Release the batch
+		Objects.Empty();
+		TArray<UPackage*> BatchPackages;
+		for (int32 Index = 0; Index < BatchNum; ++Index)
+			BatchPackages.Add(FindPackage(nullptr, *Assets[BatchStart + Index].PackageName.ToString()));
+		CollectGarbageForPackages(BatchPackages);
+	}
+
+	if (BundleWriter && !BundleWriter->Close())
+		UE_LOG(LogDemoJsonCallback, Fatal, TEXT("Unable to save file '%s'."), *OutputFile);
+	if (StreamWriter && !StreamWriter->Close())
+		UE_LOG(LogDemoJsonCallback, Fatal, TEXT("Unable to save file '%s'."), *OutputFile);
+
+	if (bIncremental && !Manifest.Save(ManifestFile))
+		UE_LOG(LogDemoJsonCallback, Error, TEXT("Unable to save manifest '%s'."), *ManifestFile);
+
+	if (bLinkerExport)
+		UE_LOG(LogDemoJsonCallback, Display, TEXT("Linker export: %d assets read from the package files (%d of them loaded for some properties), %d assets loaded."),
+			NumLinkerExported, NumLinkerPartiallyLoaded, NumExported - NumLinkerExported);
+
+	UE_LOG(LogDemoJsonCallback, Display, TEXT("--- Bulk export succesfull finished: %d assets ---"), NumExported);
+	return NumExported == Assets.Num() ? 0 : 1;
+}
+
+int32 UCustomImportCallbackCommandlet::BatchImportCase(const FString& Params)
+{
+	using namespace FCustomCallbacksDemoLocal;
+
+	// Dry run: records are only checked against the class schemas, nothing is loaded or saved
+	const bool bValidateOnly = FParse::Param(*Params, TEXT("Validate"));
+	FJsonImportValidator Validator;
+	int32 NumInvalid = 0;
+
+	UE_LOG(LogDemoJsonCallback, Display, TEXT("--- Batch %s started ---"), bValidateOnly ? TEXT("validation") : TEXT("import"));
+
+	// Records to import: separate files or lines of the stream
+	FString ImportDir;
+	FString ImportFile;
+	FString ImportBundle;
+	TArray<FString> Files;
+	TArray<FString> Lines;
+	TUniquePtr<FJsonAssetBundleReader> BundleReader;
+	TArray<FString> BundleAssetRefs;
+	if (FParse::Value(*Params, TEXT("ImportDir="), ImportDir))
+	{
+		IFileManager::Get().FindFilesRecursive(Files, *ImportDir, TEXT("*.json"), true, false);
+		IFileManager::Get().FindFilesRecursive(Files, *ImportDir, *(FString(TEXT("*")) + FJsonBinaryFormat::FileExtension), true, false, false);
+		Files.Sort();
+	}
+	else if (FParse::Value(*Params, TEXT("ImportFile="), ImportFile))
+	{
+		if (!FFileHelper::LoadFileToStringArray(Lines, *ImportFile))
+			UE_LOG(LogDemoJsonCallback, Fatal, TEXT("Unable to open file '%s'."), *ImportFile);
+		JSON_CONVERTER_COUNT(BytesRead, IFileManager::Get().FileSize(*ImportFile));
+	}
+	else if (FParse::Value(*Params, TEXT("ImportBundle="), ImportBundle))
+	{
+		// Only the index is loaded, records are read when they are imported
+		BundleReader = MakeUnique<FJsonAssetBundleReader>();
+		if (!BundleReader->Open(ImportBundle))
+			UE_LOG(LogDemoJsonCallback, Fatal, TEXT("Unable to open bundle '%s'."), *ImportBundle);
+
+		// Partial import: comma separated AssetRefs ("Class'/Game/Path.Object'") or object paths ("/Game/Path.Object")
+		FString AssetsValue;
+		if (FParse::Value(*Params, TEXT("Assets="), AssetsValue, false))
+		{
+			TArray<FString> RequestedAssets;
+			AssetsValue.ParseIntoArray(RequestedAssets, TEXT(","));
+
+			TMap<FString, FString> AssetRefByObjectPath;
+			for (const FString& RequestedAsset : RequestedAssets)
+			{
+				if (BundleReader->Contains(RequestedAsset))
+				{
+					BundleAssetRefs.Add(RequestedAsset);
+					continue;
+				}
+
+				// Object path lookup is built only when it is required
+				if (AssetRefByObjectPath.Num() == 0)
+				{
+					for (const FString& AssetRef : BundleReader->GetAssetRefs())
+					{
+						FString ObjectPath = AssetRef;
+						ConstructorHelpers::StripObjectClass(ObjectPath);
+						AssetRefByObjectPath.Add(ObjectPath, AssetRef);
+					}
+				}
+
+				if (const FString* AssetRef = AssetRefByObjectPath.Find(RequestedAsset))
+					BundleAssetRefs.Add(*AssetRef);
+				else
+					UE_LOG(LogDemoJsonCallback, Error, TEXT("Asset '%s' not found in bundle '%s'."), *RequestedAsset, *ImportBundle);
+			}
+		}
+		else
+		{
+			BundleAssetRefs = BundleReader->GetAssetRefs();
+		}
+	}
+	const int32 NumRecords = !ImportDir.IsEmpty() ? Files.Num() : BundleReader ? BundleAssetRefs.Num() : Lines.Num();
+
+	// Number of records parsed at once
+	int32 BatchSize = 256;
+	FParse::Value(*Params, TEXT("BatchSize="), BatchSize);
+	BatchSize = FMath::Max(BatchSize, 1);
+
+	// Number of dirty packages saved at once, 0 - all packages are saved at the end
+	int32 SaveChunk = 0;
+	FParse::Value(*Params, TEXT("SaveChunk="), SaveChunk);
+
+	UE_LOG(LogDemoJsonCallback, Display, TEXT("Found %d records to import."), NumRecords);
+
+	// Dirty packages are referenced only from here, so GC runs only after they are saved
+	TArray<UPackage*> DirtyPackages;
+	int32 NumSaved = 0;
+	bool bSaveFailed = false;
+	auto SaveDirtyPackages = [&]()
+	{
+		if (DirtyPackages.Num() == 0)
+			return;
+
+		JSON_CONVERTER_TIMER_SCOPE(SavePackages);
+		if (!UEditorLoadingAndSavingUtils::SavePackages(DirtyPackages, false))
+		{
+			UE_LOG(LogDemoJsonCallback, Error, TEXT("Unable to save %d packages."), DirtyPackages.Num());
+			bSaveFailed = true;
+		}
+		else
+		{
+			NumSaved += DirtyPackages.Num();
+		}
+		UE_LOG(LogDemoJsonCallback, Display, TEXT("Saved %d packages."), NumSaved);
+
+		CollectGarbageForPackages(DirtyPackages);
+		DirtyPackages.Reset();
+	};
+
+	struct FParsedRecord
+	{
+		TSharedPtr<FJsonObject> JsonObject;
+		FString ObjectPath;
+		// Short class name of "AssetRef", the class is checked after the load (blueprint class may be not loaded yet)
+		FName ClassName;
+		FString Error;
+		// All problems of the record ("-Validate")
+		TArray<FString> Problems;
+		// Memory of the arena document of the worker after the record, and whether it had to grow for the record ("-Validate")
+		SIZE_T ArenaSize = 0;
+		bool bArenaGrown = false;
+	};
+
+	// Classes are resolved by the prebuilt index (no global search per record)
+	FClassNameIndex::Get().Rebuild();
+
+	int32 NumImported = 0;
+	for (int32 BatchStart = 0; BatchStart < NumRecords; BatchStart += BatchSize)
+	{
+		const int32 BatchNum = FMath::Min(BatchSize, NumRecords - BatchStart);
+
+		// Records of the bundle are read by seeking to them (bundle reader is not thread-safe)
+		TArray<FString> BundleRecords;
+		if (BundleReader)
+		{
+			BundleRecords.SetNum(BatchNum);
+			for (int32 Index = 0; Index < BatchNum; ++Index)
+			{
+				if (!BundleReader->ReadRecord(BundleAssetRefs[BatchStart + Index], BundleRecords[Index]))
+					UE_LOG(LogDemoJsonCallback, Error, TEXT("Unable to read record '%s' from bundle '%s'."), *BundleAssetRefs[BatchStart + Index], *ImportBundle);
+			}
+		}
+
+		// Stage 1: parse and validate on worker threads
+		TArray<FParsedRecord> Records;
+		Records.SetNum(BatchNum);
+		ParallelFor(BatchNum, [&](int32 Index)
+		{
+			FParsedRecord& Record = Records[Index];
+
+			if (bValidateOnly)
+			{
+				// Records are checked in the arena of the worker thread, without FJsonValue tree per record
+				thread_local FJsonArenaDocument Document;
+				const SIZE_T ArenaSizeBefore = Document.GetAllocatedSize();
+				bool bParsed = false;
+				if (ImportDir.IsEmpty())
+				{
+					bParsed = Document.Parse(BundleReader ? BundleRecords[Index] : Lines[BatchStart + Index]);
+				}
+				else if (FJsonBinaryFormat::IsBinaryFile(Files[BatchStart + Index]))
+				{
+					Document.FromJsonValue(LoadJsonFile(Files[BatchStart + Index]));
+					bParsed = !Document.IsEmpty();
+				}
+				else
+				{
+					FString JsonText;
+					JSON_CONVERTER_COUNT(BytesRead, IFileManager::Get().FileSize(*Files[BatchStart + Index]));
+					bParsed = FFileHelper::LoadFileToString(JsonText, *Files[BatchStart + Index]) && Document.Parse(JsonText);
+				}
+
+				// Interned references are restored through the json tree (only the records with the table)
+				if (bParsed && Document.FindField(FJsonArenaDocument::RootIndex, FJsonReferenceTable::TableFieldName) != INDEX_NONE)
+				{
+					const TSharedPtr<FJsonValue> JsonValue = Document.ToJsonValue();
+					bParsed = FJsonReferenceTable::ExpandReferences(JsonValue->AsObject().ToSharedRef());
+					Document.FromJsonValue(JsonValue);
+				}
+
+				if (!bParsed)
+					Record.Problems.Add(Document.GetErrorMessage().IsEmpty() ? TEXT("unexpected content") : Document.GetErrorMessage());
+				else
+					Validator.ValidateRecord(Document, Record.Problems);
+				Record.ArenaSize = Document.GetAllocatedSize();
+				Record.bArenaGrown = Record.ArenaSize > ArenaSizeBefore;
+				return;
+			}
+
+			TSharedPtr<FJsonValue> JsonValue;
+			if (!ImportDir.IsEmpty())
+				JsonValue = LoadJsonFile(Files[BatchStart + Index]);
+			else
+				FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(BundleReader ? BundleRecords[Index] : Lines[BatchStart + Index]), JsonValue);
+
+			const TSharedPtr<FJsonObject>* JsonObject;
+			if (!JsonValue.IsValid() || !JsonValue->TryGetObject(JsonObject) || !FJsonReferenceTable::ExpandReferences(JsonObject->ToSharedRef()))
+			{
+				Record.Error = TEXT("unexpected content");
+				return;
+			}
+
+			FString AssetRef;
+			if (!(*JsonObject)->TryGetStringField(AssetRefPropertyName, AssetRef))
+			{
+				Record.Error = FString::Printf(TEXT("field '%s' not found"), *AssetRefPropertyName);
+				return;
+			}
+
+			const FObjectPathView PathView = FObjectPathSplitter::Split(AssetRef);
+			if (PathView.ClassName.IsEmpty() || PathView.PackageName.IsEmpty() || PathView.ObjectName.IsEmpty() || !PathView.SubObjectName.IsEmpty())
+			{
+				Record.Error = FString::Printf(TEXT("invalid asset reference '%s'"), *AssetRef);
+				return;
+			}
+
+			Record.ClassName = FName(PathView.ClassName.Len(), PathView.ClassName.GetData());
+
+			// All fields must match the properties of the class (the object table is checked by the import).
+			// The class which is not in memory (blueprint class) is checked by the import after the load
+			if (const UClass* Class = FClassNameIndex::Get().FindClass(Record.ClassName))
+			{
+				const FPropertySchema& Schema = FPropertySchemaCache::Get().GetSchema(Class);
+				for (const TPair<FString, TSharedPtr<FJsonValue>>& JsonField : (*JsonObject)->Values)
+				{
+					if (!IsRecordMetadataField(JsonField.Key) && JsonField.Key != FJsonObjectGraph::ObjectsFieldName && !Schema.FindProperty(JsonField.Key))
+					{
+						Record.Error = FString::Printf(TEXT("property '%s' not found in class %s"), *JsonField.Key, *Class->GetName());
+						return;
+					}
+				}
+			}
+
+			Record.ObjectPath = FString(PathView.PackageName.Len(), PathView.PackageName.GetData()) + TEXT(".") + FString(PathView.ObjectName.Len(), PathView.ObjectName.GetData());
+			Record.JsonObject = *JsonObject;
+		});
+
+		auto GetRecordName = [&](int32 Index)
+		{
+			return !ImportDir.IsEmpty() ? Files[BatchStart + Index]
+				: BundleReader ? BundleAssetRefs[BatchStart + Index]
+				: FString::Printf(TEXT("%s:%d"), *ImportFile, BatchStart + Index + 1);
+		};
+
+		if (bValidateOnly)
+		{
+			// Arenas of the workers should stop growing after the first records
+			int32 NumArenaGrown = 0;
+			SIZE_T MaxArenaSize = 0;
+			for (int32 Index = 0; Index < BatchNum; ++Index)
+			{
+				FParsedRecord& Record = Records[Index];
+				NumArenaGrown += Record.bArenaGrown ? 1 : 0;
+				MaxArenaSize = FMath::Max(MaxArenaSize, Record.ArenaSize);
+				if (!Record.Error.IsEmpty())
+					Record.Problems.Insert(Record.Error, 0);
+				if (Record.Problems.Num() == 0)
+					continue;
+
+				++NumInvalid;
+				const FString RecordName = GetRecordName(Index);
+				for (const FString& Problem : Record.Problems)
+					UE_LOG(LogDemoJsonCallback, Error, TEXT("%s: %s."), *RecordName, *Problem);
+			}
+			UE_LOG(LogDemoJsonCallback, Display, TEXT("Validated %d/%d records (arena grown for %d records of the batch, largest arena %.1f KB)."),
+				BatchStart + BatchNum, NumRecords, NumArenaGrown, MaxArenaSize / 1024.0);
+			continue;
+		}
+
+		// Stage 2: load the assets and apply the properties on the game thread
+		for (int32 Index = 0; Index < BatchNum; ++Index)
+		{
+			const FParsedRecord& Record = Records[Index];
+			const FString RecordName = GetRecordName(Index);
+			if (!Record.Error.IsEmpty())
+			{
+				UE_LOG(LogDemoJsonCallback, Error, TEXT("Record '%s' skipped: %s."), *RecordName, *Record.Error);
+				continue;
+			}
+
+			UObject* Object = LoadObject<UObject>(nullptr, *Record.ObjectPath);
+			if (!Object)
+			{
+				UE_LOG(LogDemoJsonCallback, Error, TEXT("Record '%s' skipped: unable to load object '%s'."), *RecordName, *Record.ObjectPath);
+				continue;
+			}
+
+			// The class of "AssetRef" is the class of the object or its super class
+			const UClass* Class = Object->GetClass();
+			while (Class && Class->GetFName() != Record.ClassName)
+				Class = Class->GetSuperClass();
+			if (!Class)
+			{
+				UE_LOG(LogDemoJsonCallback, Error, TEXT("Record '%s' skipped: object '%s' of class %s is not %s."), *RecordName, *Record.ObjectPath, *Object->GetClass()->GetName(), *Record.ClassName.ToString());
+				continue;
+			}
+
+			bool bImported = false;
+			{
+				JSON_CONVERTER_TIMER_SCOPE(Import);
+				bImported = ImportObjectProperties(Object, Record.JsonObject.ToSharedRef());
+			}
+			// Known properties are saved anyway, but the record is not counted as imported
+			if (!bImported)
+				UE_LOG(LogDemoJsonCallback, Error, TEXT("Record '%s' imported partially: unexpected properties for class %s."), *RecordName, *Object->GetClass()->GetName());
+			Object->MarkPackageDirty();
+			DirtyPackages.AddUnique(Object->GetOutermost());
+			NumImported += bImported ? 1 : 0;
+
+			// Stage 3: save by chunks
+			if (SaveChunk > 0 && DirtyPackages.Num() >= SaveChunk)
+				SaveDirtyPackages();
+		}
+
+		UE_LOG(LogDemoJsonCallback, Display, TEXT("Imported %d/%d records."), NumImported, NumRecords);
+	}
+
+	if (bValidateOnly)
+	{
+		UE_LOG(LogDemoJsonCallback, Display, TEXT("--- Batch validation finished: %d of %d records have problems ---"), NumInvalid, NumRecords);
+		return NumInvalid == 0 ? 0 : 1;
+	}
+
+	// Stage 3: save the rest of dirty packages at once
+	SaveDirtyPackages();
+
+	UE_LOG(LogDemoJsonCallback, Display, TEXT("--- Batch import finished: %d records imported, %d packages saved ---"), NumImported, NumSaved);
+	return NumImported == NumRecords && !bSaveFailed ? 0 : 1;
+}
+
+void UCustomImportCallbackCommandlet::StreamExportCase(const FString& InReferenceString, const FString& InSaveFilePath)
+{
+	UE_LOG(LogDemoJsonCallback, Display, TEXT("--- Streaming export started ---"));
+	JSON_CONVERTER_TIMER_SCOPE(Export);
+
+	// Get asset package
+	FString PackagePath = InReferenceString;
+	ConstructorHelpers::StripObjectClass(PackagePath);
+
+	// Load object by path 
+	UObject* Object = LoadObject<UObject>(nullptr, *PackagePath);
+	if (!Object)
+		UE_LOG(LogDemoJsonCallback, Fatal, TEXT("Unable to load object '%s'."), *PackagePath);
+
+	// Properties are written into the file while iterating them
+	TUniquePtr<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*InSaveFilePath));
+	if (!FileWriter)
+		UE_LOG(LogDemoJsonCallback, Fatal, TEXT("Unable to save file '%s'."), *InSaveFilePath);
+
+	FJsonPropertyStreamWriter JsonWriter(FileWriter.Get());
+	JsonWriter.WriteObject(Object);
+	if (!JsonWriter.Close() || !FileWriter->Close())
+		UE_LOG(LogDemoJsonCallback, Fatal, TEXT("Unable to save file '%s'."), *InSaveFilePath);
+	if (!JsonWriter.GetErrorMessage().IsEmpty())
+		UE_LOG(LogDemoJsonCallback, Fatal, TEXT("%s"), *JsonWriter.GetErrorMessage());
+	JSON_CONVERTER_COUNT(BytesWritten, FileWriter->TotalSize());
+	FileWriter.Reset();
+
+	LogPayloadFile(InSaveFilePath);
+
+	UE_LOG(LogDemoJsonCallback, Display, TEXT("--- Streaming export succesfull finished ---"));
+}
+
+int32 UCustomImportCallbackCommandlet::ConvertCase(const FString& Params)
+{
+	FString InputFilePath;
+	if (FParse::Value(*Params, TEXT("ConvertToBundle="), InputFilePath))
+	{
+		FString OutputFilePath = FPaths::ChangeExtension(InputFilePath, FJsonAssetBundle::FileExtension);
+		FParse::Value(*Params, TEXT("Output="), OutputFilePath);
+		if (!FJsonAssetBundle::ConvertJsonToBundle(InputFilePath, OutputFilePath))
+		{
+			UE_LOG(LogDemoJsonCallback, Error, TEXT("Unable to convert '%s' to '%s'."), *InputFilePath, *OutputFilePath);
+			return 1;
+		}
+
+		UE_LOG(LogDemoJsonCallback, Display, TEXT("Converted '%s' to bundle '%s' (%lld bytes)."), *InputFilePath, *OutputFilePath, IFileManager::Get().FileSize(*OutputFilePath));
+		return 0;
+	}
+
+	const bool bToBinary = FParse::Value(*Params, TEXT("ConvertToBinary="), InputFilePath);
+	if (!bToBinary)
+		FParse::Value(*Params, TEXT("ConvertToJson="), InputFilePath);
+
+	FString OutputFilePath = FPaths::ChangeExtension(InputFilePath, bToBinary ? FJsonBinaryFormat::FileExtension : TEXT(".json"));
+	FParse::Value(*Params, TEXT("Output="), OutputFilePath);
+
+	const bool bResult = bToBinary
+		? FJsonBinaryFormat::ConvertJsonToBinary(InputFilePath, OutputFilePath)
+		: FJsonBinaryFormat::ConvertBinaryToJson(InputFilePath, OutputFilePath);
+	if (!bResult)
+	{
+		UE_LOG(LogDemoJsonCallback, Error, TEXT("Unable to convert '%s' to '%s'."), *InputFilePath, *OutputFilePath);
+		return 1;
+	}
+
+	JSON_CONVERTER_COUNT(BytesRead, IFileManager::Get().FileSize(*InputFilePath));
+	JSON_CONVERTER_COUNT(BytesWritten, IFileManager::Get().FileSize(*OutputFilePath));
+	UE_LOG(LogDemoJsonCallback, Display, TEXT("Converted '%s' (%lld bytes) to '%s' (%lld bytes)."),
+		*InputFilePath, IFileManager::Get().FileSize(*InputFilePath), *OutputFilePath, IFileManager::Get().FileSize(*OutputFilePath));
+	return 0;
+}
+
+void UCustomImportCallbackCommandlet::SaveToJsonFile(const TSharedPtr<FJsonObject> InJsonObject, const FString& InSaveFilePath)
+{
+	const FString SerializedJson = SerializeJson(InJsonObject);	
+	// Save to file
+	JSON_CONVERTER_TIMER_SCOPE(SaveFile);
+	// UTF-8 as the other writers (AutoDetect would write UTF-16 for non-ANSI text)
+	if (!FFileHelper::SaveStringToFile(SerializedJson, *InSaveFilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+		UE_LOG(LogDemoJsonCallback, Fatal, TEXT("Unable to save file '%s'."), *InSaveFilePath);
+	JSON_CONVERTER_COUNT(BytesWritten, IFileManager::Get().FileSize(*InSaveFilePath));
+}
+
+FString UCustomImportCallbackCommandlet::SerializeJson(const TSharedPtr<FJsonObject> InJsonObject)
+{
+	// Serialize
+	FString SerializedJson;
+	TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&SerializedJson);
+	FJsonSerializer::Serialize(InJsonObject.ToSharedRef(), TJsonWriterFactory<>::Create(&SerializedJson));
+	
+	LogPayload(SerializedJson);
+
+	return SerializedJson;
+}
+
+void UCustomImportCallbackCommandlet::LogPayload(const FString& InPayload) const
+{
+	if (!bLogPayload)
+		return;
+
+	if (InPayload.Len() <= MaxLoggedPayloadLen)
+	{
+		UE_LOG(LogDemoJsonCallback, Display, TEXT("Export custom result:\n%s"), *InPayload);
+		return;
+	}
+
+	UE_LOG(LogDemoJsonCallback, Display, TEXT("Export custom result (first %d of %d characters):\n%s"), MaxLoggedPayloadLen, InPayload.Len(), *InPayload.Left(MaxLoggedPayloadLen));
+}
+
+void UCustomImportCallbackCommandlet::LogPayloadFile(const FString& InFilePath) const
+{
+	if (!bLogPayload)
+		return;
+
+	// Read only the logged part of the file
+	TUniquePtr<FArchive> FileReader(IFileManager::Get().CreateFileReader(*InFilePath));
+	if (!FileReader)
+		return;
+
+	const int64 FileSize = FileReader->TotalSize();
+	TArray<uint8> Bytes;
+	Bytes.SetNumUninitialized(FMath::Min<int64>(FileSize, MaxLoggedPayloadLen));
+	FileReader->Serialize(Bytes.GetData(), Bytes.Num());
+
+	const FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), Bytes.Num());
+	const FString Payload(Converter.Length(), Converter.Get());
+	if (Bytes.Num() == FileSize)
+	{
+		UE_LOG(LogDemoJsonCallback, Display, TEXT("Export custom result:\n%s"), *Payload);
+		return;
+	}
+
+	UE_LOG(LogDemoJsonCallback, Display, TEXT("Export custom result (first %d of %lld bytes):\n%s"), Bytes.Num(), FileSize, *Payload);
+}
+
+void UCustomImportCallbackCommandlet::ReportStats(const FString& Params, const FString& InMode) const
+{
+	FJsonConverterStats::Get().PrintSummary();
+
+	FString CsvFilePath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("JsonConverterStats.csv"));
+	FParse::Value(*Params, TEXT("StatsCsv="), CsvFilePath);
+	if (!FJsonConverterStats::Get().AppendCsv(CsvFilePath, InMode))
+	{
+		UE_LOG(LogDemoJsonCallback, Error, TEXT("Unable to save file '%s'."), *CsvFilePath);
+		return;
+	}
+	UE_LOG(LogDemoJsonCallback, Display, TEXT("Stats appended to '%s'."), *CsvFilePath);
+}
+
+namespace FCustomCallbacksDemoLocal
+{
+	// Load data from json file
+	TSharedPtr<FJsonValue> LoadJsonFile(FString const& FilePath)
+	{
+		JSON_CONVERTER_TIMER_SCOPE(LoadFile);
+		JSON_CONVERTER_COUNT(BytesRead, IFileManager::Get().FileSize(*FilePath));
+
+		TSharedPtr<FJsonValue> JsonFile;
+		// The binary interchange format has the same semantics
+		if (FJsonBinaryFormat::IsBinaryFile(FilePath))
+		{
+			JsonFile = FJsonBinaryFormat::LoadFromFile(FilePath);
+			if (!JsonFile.IsValid())
+				return nullptr;
+		}
+		else
+		{
+			// load text file
+			FString FileText;
+			if (!FFileHelper::LoadFileToString(FileText, *FilePath))
+				return nullptr;
+
+			// parse as json
+			const TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(FileText);
+			if (!FJsonSerializer::Deserialize(JsonReader, JsonFile))
+				return nullptr;
+		}
+
+		// Interned references are restored once per file
+		const TSharedPtr<FJsonObject>* JsonObject;
+		if (JsonFile->TryGetObject(JsonObject) && !FJsonReferenceTable::ExpandReferences(JsonObject->ToSharedRef()))
+			return nullptr;
+
+		return JsonFile;
+	}
+	
+	// FPackageName::SplitFullObjectPath(StringValue, ClassName, PackagePath, ObjectName, SubObjectName);
+	// TODO: https://github.com/EpicGames/UnrealEngine/pull/7371
+	void CustomSplitFullObjectPath(const FString& InFullObjectPath, FString& OutClassName, FString& OutPackageName, FString& OutObjectName, FString& OutSubObjectName)
+	{
+		// Thin wrapper over the allocation-free splitter
+		const FObjectPathView PathView = FObjectPathSplitter::Split(InFullObjectPath);
+		OutClassName = FString(PathView.ClassName.Len(), PathView.ClassName.GetData());
+		OutPackageName = FString(PathView.PackageName.Len(), PathView.PackageName.GetData());
+		OutObjectName = FString(PathView.ObjectName.Len(), PathView.ObjectName.GetData());
+		OutSubObjectName = FString(PathView.SubObjectName.Len(), PathView.SubObjectName.GetData());
+	}
+
+	// Textual reference of the object property value. If the value is an instanced (sub) object, returns this object,
+	// otherwise returns nullptr and the value must be exported as the string reference
+	UObject* ResolveInstancedSubObject(FProperty* Property, const void* Value, FString& OutReferenceString, FString& OutError)
+	{
+		// Fast path: the object pointer is read straight from the property value, without string round-trip
+		if (FObjectProperty* ObjectProperty = CastField<FObjectProperty>(Property))
+		{
+			UObject* Object = ObjectProperty->GetObjectPropertyValue(Value);
+			// Text of the reference is formatted once per unique object
+			OutReferenceString = FObjectExportPathCache::Get().GetExportPath(Object);
+
+			// Instanced (sub) object is not a direct child of the package: its reference contains the sub object name
+			if (Object && Object->GetOuter() && !Object->GetOuter()->IsA<UPackage>())
+				return Object;
+			return nullptr;
+		}
+
+		Property->ExportTextItem(OutReferenceString, Value, NULL, NULL, PPF_None);
+
+		// This don`t work. See PR: https://github.com/EpicGames/UnrealEngine/pull/7371
+		//FPackageName::SplitFullObjectPath(StringValue, ClassName, PackagePath, ObjectName, SubObjectName);
+		const FObjectPathView PathView = FObjectPathSplitter::Split(OutReferenceString);
+
+		// If this ObjectProperty not include instanced object
+		if (PathView.SubObjectName.IsEmpty())
+			return nullptr;
+
+		FString ObjectPath = OutReferenceString;
+		ConstructorHelpers::StripObjectClass(ObjectPath);
+
+		// Loading is allowed only on the game thread. On worker threads (bulk export)
+		// instanced subobject is already in memory together with its outer
+		UObject* Object = IsInGameThread() ? LoadObject<UObject>(nullptr, *ObjectPath) : FindObject<UObject>(nullptr, *ObjectPath);
+		if (!Object)
+			OutError = FString::Printf(TEXT("Unable to load object '%s'."), *ObjectPath);
+
+		return Object;
+	}
+
+	// Json of the object reference: instanced (sub) object as json object with "SubObjectRef", otherwise the string reference
+	TSharedPtr<FJsonValue> ObjectToJsonValue(const UObject* Object)
+	{
+		// Text of the reference is formatted once per unique object
+		const FString& StringValue = FObjectExportPathCache::Get().GetExportPath(Object);
+
+		// If this object is not instanced (sub) object: its outer is the package
+		if (!Object || !Object->GetOuter() || Object->GetOuter()->IsA<UPackage>())
+			// Then return String Reference on this object
+			return MakeShared<FJsonValueString>(StringValue);
+
+		// Graph-aware export: only the id, the properties are exported once by FJsonObjectGraph::ExportObject
+		if (const TSharedPtr<FJsonValue> GraphReference = FJsonObjectGraph::GetObjectReference(Object))
+			return GraphReference;
+
+		// Create json object
+		TSharedPtr<FJsonObject> JsonInstancedObject = MakeShared<FJsonObject>();
+		// Add custom Property for save sub (instanced) object full path
+		JsonInstancedObject->SetField(CustomAdditionalPropertyName, MakeShared<FJsonValueString>(StringValue));
+		// Iterate by sub (instanced) object properties
+		ExportObjectProperties(Object, JsonInstancedObject.ToSharedRef());
+
+		return MakeShared<FJsonValueObject>(JsonInstancedObject);
+	}
+
+	// Object of the json value written by ObjectToJsonValue
+	bool JsonValueToObject(const TSharedPtr<FJsonValue>& JsonValue, UObject*& OutObject)
+	{
+		OutObject = nullptr;
+
+		const TSharedPtr<FJsonObject>* JsonObject;
+		if (JsonValue->TryGetObject(JsonObject))
+		{
+			FString SubObjectRef;
+			if (!(*JsonObject)->TryGetStringField(CustomAdditionalPropertyName, SubObjectRef))
+				return false;
+
+			OutObject = CreateInstancedSubObject(SubObjectRef);
+			if (OutObject == nullptr)
+				return false;
+			return ImportObjectProperties(OutObject, JsonObject->ToSharedRef());
+		}
+
+		FString StringValue;
+		if (!JsonValue->TryGetString(StringValue))
+			return JsonValue->IsNull();
+		if (StringValue.IsEmpty() || StringValue == TEXT("None"))
+			return true;
+
+		ConstructorHelpers::StripObjectClass(StringValue);
+		OutObject = LoadObject<UObject>(nullptr, *StringValue);
+		return OutObject != nullptr;
+	}
+
+	bool JsonValueToObjectOfClass(const TSharedPtr<FJsonValue>& JsonValue, const UClass* PropertyClass, UObject*& InOutObject)
+	{
+		UObject* Object = nullptr;
+		const bool bImported = JsonValueToObject(JsonValue, Object);
+		if (Object && !Object->IsA(PropertyClass))
+		{
+			UE_LOG(LogDemoJsonCallback, Error, TEXT("Object '%s' is not %s."), *Object->GetPathName(), *PropertyClass->GetName());
+			return false;
+		}
+
+		// Partially imported sub object is assigned as well: it exists in the package anyway
+		if (bImported || Object)
+			InOutObject = Object;
+		return bImported;
+	}
+
+	bool ImportPropertyValue(FProperty* Property, const TSharedPtr<FJsonValue>& JsonValue, void* OutValue)
+	{
+		// References to other objects are resolved once per unique reference
+		if (FObjectImportReferenceCache::Get().ImportObjectReferences(Property, JsonValue, OutValue))
+			return true;
+
+		// JsonValueToUProperty doesn't create the instanced objects: they are created by JsonValueToObjectOfClass
+		// (also inside arrays and structs), the same as by the typed serializers
+		if (Property->ArrayDim == 1 && Property->ContainsInstancedObjectProperty())
+		{
+			if (FObjectProperty* ObjectProperty = CastField<FObjectProperty>(Property))
+			{
+				UObject* Object = ObjectProperty->GetObjectPropertyValue(OutValue);
+				const bool bImported = JsonValueToObjectOfClass(JsonValue, ObjectProperty->PropertyClass, Object);
+				ObjectProperty->SetObjectPropertyValue(OutValue, Object);
+				return bImported;
+			}
+
+			FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property);
+			const TArray<TSharedPtr<FJsonValue>>* JsonElements;
+			if (ArrayProperty && JsonValue->TryGetArray(JsonElements))
+			{
+				FScriptArrayHelper ArrayHelper(ArrayProperty, OutValue);
+				ArrayHelper.Resize(JsonElements->Num());
+				bool bResult = true;
+				for (int32 Index = 0; Index < JsonElements->Num(); ++Index)
+					bResult &= ImportPropertyValue(ArrayProperty->Inner, (*JsonElements)[Index], ArrayHelper.GetRawPtr(Index));
+				return bResult;
+			}
+
+			FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+			const TSharedPtr<FJsonObject>* JsonObject;
+			if (StructProperty && JsonValue->TryGetObject(JsonObject))
+			{
+				const FPropertySchema& Schema = FPropertySchemaCache::Get().GetSchema(StructProperty->Struct);
+				bool bResult = true;
+				for (const TPair<FString, TSharedPtr<FJsonValue>>& JsonField : (*JsonObject)->Values)
+				{
+					const FCachedProperty* CachedProperty = Schema.FindProperty(JsonField.Key);
+					if (CachedProperty == nullptr)
+					{
+						UE_LOG(LogDemoJsonCallback, Error, TEXT("Property '%s' not found in %s."), *JsonField.Key, *StructProperty->Struct->GetName());
+						bResult = false;
+						continue;
+					}
+					bResult &= ImportPropertyValue(CachedProperty->Property, JsonField.Value, CachedProperty->GetValuePtr(OutValue));
+				}
+				return bResult;
+			}
+		}
+
+		/* TODO: Uncomment next lines when CustomImportCallback if it is available in FJsonObjectConverter::JsonValueToUProperty*/
+		// FJsonObjectConverter::CustomImportCallback CustomCB;
+		// CustomCB.BindStatic(JsonToObjectCallback);
+		return FJsonObjectConverter::JsonValueToUProperty(
+			JsonValue,
+			Property,
+			OutValue,
+			0,
+			0
+			// /* TODO: Uncomment next arg if it is available in FJsonObjectConverter::JsonValueToUProperty*/ , &CustomCB
+			);
+	}
+
+	// Implementation for CustomExportCallback (Example of use)
+	TSharedPtr<FJsonValue> ObjectJsonCallback(FProperty* Property, const void* Value)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(ObjectJsonCallback);
+		if (FObjectProperty* ObjectProperty = CastField<FObjectProperty>(Property))
+			return ObjectToJsonValue(ObjectProperty->GetObjectPropertyValue(Value));
+
+		// invalid
+		return TSharedPtr<FJsonValue>();
+	}
+
+	// Create instanced (sub) object by its textual reference "Class'/Package.Object:SubObject'"
+	UObject* CreateInstancedSubObject(const FString& SubObjectRef)
+	{
+		// Detect instanced object
+		FString ClassName;
+		FString PackagePath;
+		FString ObjectName;
+		FString SubObjectName;
+		
+		// TODO: https://github.com/EpicGames/UnrealEngine/pull/7371
+		// FPackageName::SplitFullObjectPath(StringValue, ClassName, PackagePath, ObjectName, SubObjectName);
+		CustomSplitFullObjectPath(SubObjectRef, ClassName, PackagePath, ObjectName, SubObjectName);
+
+		if (SubObjectName.IsEmpty())
+			return nullptr;
+
+		UClass* ObjectClass = FClassNameIndex::Get().FindClass(ClassName);
+		if (ObjectClass == nullptr)
+		{
+			UE_LOG(LogDemoJsonCallback, Fatal, TEXT("Class '%s' not found or ambiguous."), *ClassName);
+			return nullptr;
+		}
+
+		// Nested sub object "Object:Outer.SubObject" is created inside its direct outer
+		FString OuterObjectPath = FString::Printf(TEXT("%s.%s"), *PackagePath, *ObjectName);
+		FString OuterSubObjectPath;
+		if (SubObjectName.Split(TEXT("."), &OuterSubObjectPath, &SubObjectName, ESearchCase::CaseSensitive, ESearchDir::FromEnd))
+			OuterObjectPath += SUBOBJECT_DELIMITER + OuterSubObjectPath;
+
+		UObject* OuterObject = LoadObject<UObject>(nullptr, *OuterObjectPath);
+		if (OuterObject == nullptr)
+			UE_LOG(LogDemoJsonCallback, Fatal, TEXT("Unable to load object '%s'."), *OuterObjectPath);
+
+		// Existing sub object with the same name and class is updated in place,
+		// so repeated imports don't leave orphaned sub objects in the package
+		const FName SubObjectFName(*SubObjectName);
+		UObject* SubObject = StaticFindObjectFast(UObject::StaticClass(), OuterObject, SubObjectFName);
+		if (SubObject && SubObject->GetClass() != ObjectClass)
+		{
+			// The name is taken by the object of the other class: move it out of the package
+			SubObject->Rename(nullptr, GetTransientPackage(), REN_DontCreateRedirectors | REN_DoNotDirty | REN_NonTransactional | REN_ForceNoResetLoaders);
+			SubObject = nullptr;
+		}
+
+		if (SubObject == nullptr)
+		{
+			SubObject = NewObject<UObject>(OuterObject, ObjectClass, SubObjectFName);
+			JSON_CONVERTER_COUNT(SubObjectsCreated, 1);
+		}
+		if (SubObject == nullptr)
+			UE_LOG(LogDemoJsonCallback, Fatal, TEXT("Sub Object '%s' for object '%s' was not created."), *SubObjectName, *OuterObjectPath);
+
+		return SubObject;
+	}
+
+	// Implementation for my CustomImportCallback (Example of use)
+	bool JsonToObjectCallback(const TSharedPtr<FJsonValue>& JsonValue, FProperty* Property , void* OutValue)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(JsonToObjectCallback);
+		const TSharedPtr<FJsonObject>* JsonObject;
+		if (!JsonValue->TryGetObject(JsonObject))
+			// By default, false, means not handled
+			return false;
+		
+		FString SubObjectRef;
+		if (!(*JsonObject)->TryGetStringField(CustomAdditionalPropertyName, SubObjectRef))
+			// JsonObject don`t have custom sub object (instanced object),
+			// so the import is not finished and you need to continue the import chain
+			// False - means not handled
+			return false;
+		
+		UObject* SubObject = CreateInstancedSubObject(SubObjectRef);
+		if (SubObject == nullptr)
+			// The textual representation of a link to a sub-object does not contain its name.
+			// This may mean that this is not a link to an instantiated object (sub object),
+			// but to a third-party object from another package
+			// False - means not handled
+			return false;
+
+		UClass* ObjectClass = SubObject->GetClass();
+		const FPropertySchema& Schema = FPropertySchemaCache::Get().GetSchema(ObjectClass);
+		JSON_CONVERTER_COUNT(ObjectsVisited, 1);
+		
+		// Let's go through the properties of the sub-object recursively to restore them.
+		for (auto && PropertyJsonValuePair : (*JsonObject)->Values)
+		{
+			if (PropertyJsonValuePair.Key == CustomAdditionalPropertyName)
+				continue;
+		
+			const FCachedProperty* CachedProperty = Schema.FindProperty(PropertyJsonValuePair.Key);
+			if (!CachedProperty)
+			{
+				UE_LOG(LogDemoJsonCallback, Error, TEXT("Property %s for object class %s not found."), *PropertyJsonValuePair.Key, *ObjectClass->GetName());
+				continue;
+			}
+			FProperty* SubObjectProperty = CachedProperty->Property;
+			JSON_CONVERTER_COUNT(PropertiesConverted, 1);
+
+			ImportPropertyValue(SubObjectProperty, PropertyJsonValuePair.Value, CachedProperty->GetValuePtr(SubObject));
+		}
+
+		// After the properties for the sub object are restored, you need to write a link to this object in the current property
+		if (FObjectProperty* ObjectProperty = CastField<FObjectProperty>(Property))
+			ObjectProperty->SetObjectPropertyValue(OutValue, SubObject);
+		
+		// All the steps have been passed, the json object has been converted to an object and saved to a property,
+		// which means that for this stage the processing is over and there is no point in continuing the import chain for this property
+		// True - means to handled
+		return true;
+	}
+
+	static bool bExportDelta = false;
+
+	void SetExportDelta(bool bInExportDelta)
+	{
+		bExportDelta = bInExportDelta;
+	}
+
+	bool IsExportDelta()
+	{
+		return bExportDelta;
+	}
+
+	// Whether all elements of the property are equal in both containers
+	static bool IsIdenticalToArchetype(const FProperty* Property, const UObject* Object, const UObject* Archetype)
+	{
+		for (int32 Index = 0; Index < Property->ArrayDim; ++Index)
+		{
+			if (!Property->Identical_InContainer(Object, Archetype, Index, PPF_None))
+				return false;
+		}
+		return true;
+	}
+
+	// Convert all properties of the object into fields of JsonObject (using ObjectJsonCallback for object properties)
+	void ExportObjectProperties(const UObject* Object, const TSharedRef<FJsonObject>& OutJsonObject)
+	{
+		const UClass* Class = Object->GetClass();
+		// Delta: the values are compared with the archetype before conversion, so the unchanged ones cost no json at all
+		const UObject* Archetype = bExportDelta ? Object->GetArchetype() : nullptr;
+		if (Archetype)
+			OutJsonObject->SetBoolField(DeltaFieldName, true);
+
+		// Own fields of the registered types are written directly, without reflection (all of them, so not in delta mode)
+		const FJsonTypedSerializer* TypedSerializer = Archetype ? nullptr : FJsonTypedSerializerRegistry::Get().Find(Class);
+		if (TypedSerializer)
+			TypedSerializer->ExportFields(Object, *OutJsonObject);
+
+		// Properties, names and custom callbacks (ObjectJsonCallback) are prepared once per class
+		const FPropertySchema& Schema = FPropertySchemaCache::Get().GetSchema(Class);
+		int32 NumConverted = 0;
+		for (const FCachedProperty& CachedProperty : Schema.Properties)
+		{
+			if (TypedSerializer && CachedProperty.Property->GetOwnerStruct() == Class)
+				continue;
+			if (Archetype && IsIdenticalToArchetype(CachedProperty.Property, Object, Archetype))
+				continue;
+
+			// Convert property to JsonValue
+			const TSharedPtr<FJsonValue> JsonValue = FJsonObjectConverter::UPropertyToJsonValue(CachedProperty.Property, CachedProperty.GetValuePtr(Object), 0, 0, CachedProperty.ExportCallback);
+			// And collect it into JsonObject
+			OutJsonObject->SetField(CachedProperty.ObjectFieldName, JsonValue);
+			++NumConverted;
+		}
+
+		JSON_CONVERTER_COUNT(ObjectsVisited, 1);
+		JSON_CONVERTER_COUNT(PropertiesConverted, TypedSerializer ? Schema.Properties.Num() : NumConverted);
+	}
+
+	// Restore properties of the object from fields of JsonObject ("AssetRef" is skipped)
+	bool ImportObjectProperties(UObject* Object, const TSharedRef<FJsonObject>& InJsonObject)
+	{
+		// Sub objects of the graph-aware export are created first, then this function is called again without the table
+		if (InJsonObject->HasField(FJsonObjectGraph::ObjectsFieldName))
+			return FJsonObjectGraph::ImportObject(Object, InJsonObject);
+
+		bool bResult = true;
+		const FPropertySchema& Schema = FPropertySchemaCache::Get().GetSchema(Object->GetClass());
+		const FJsonTypedSerializer* TypedSerializer = FJsonTypedSerializerRegistry::Get().Find(Object->GetClass());
+		JSON_CONVERTER_COUNT(ObjectsVisited, 1);
+		for (TPair<FString, TSharedPtr<FJsonValue>> const& JsonObjectItemPair : InJsonObject->Values)
+		{
+			if (IsRecordMetadataField(JsonObjectItemPair.Key) || JsonObjectItemPair.Key == CustomAdditionalPropertyName)
+				continue;
+
+			// Own fields of the registered types are read directly, without reflection
+			const EJsonTypedImportResult TypedResult = TypedSerializer ? TypedSerializer->ImportField(JsonObjectItemPair.Key, JsonObjectItemPair.Value, Object) : EJsonTypedImportResult::NotOwnField;
+			if (TypedResult != EJsonTypedImportResult::NotOwnField)
+			{
+				JSON_CONVERTER_COUNT(PropertiesConverted, 1);
+				bResult &= TypedResult == EJsonTypedImportResult::Imported;
+				continue;
+			}
+
+			const FCachedProperty* CachedProperty = Schema.FindProperty(JsonObjectItemPair.Key);
+			if (CachedProperty == nullptr)
+			{
+				UE_LOG(LogDemoJsonCallback, Error, TEXT("Property '%s' not found in class %s. Property scepped."), *JsonObjectItemPair.Key, *Object->GetClass()->GetName());
+				bResult = false;
+				continue;
+			}
+			JSON_CONVERTER_COUNT(PropertiesConverted, 1);
+
+			if (!ImportPropertyValue(CachedProperty->Property, JsonObjectItemPair.Value, CachedProperty->GetValuePtr(Object)))
+			{
+				UE_LOG(LogDemoJsonCallback, Error, TEXT("Unable to import property '%s' of %s."), *JsonObjectItemPair.Key, *Object->GetPathName());
+				bResult = false;
+			}
+		}
+
+		// Delta: missing fields keep the values of the archetype, also when the object is imported over the changed one
+		if (InJsonObject->HasField(DeltaFieldName))
+		{
+			TBitArray<> PresentProperties(false, Schema.Properties.Num());
+			for (int32 Index = 0; Index < Schema.Properties.Num(); ++Index)
+				PresentProperties[Index] = InJsonObject->HasField(Schema.Properties[Index].ObjectFieldName);
+			ResetMissingPropertiesToArchetype(Object, PresentProperties);
+		}
+		return bResult;
+	}
+
+	void ResetMissingPropertiesToArchetype(UObject* Object, const TBitArray<>& PresentProperties)
+	{
+		const UObject* Archetype = Object->GetArchetype();
+		if (!Archetype)
+			return;
+
+		const FPropertySchema& Schema = FPropertySchemaCache::Get().GetSchema(Object->GetClass());
+		bool bCopiedInstancedReferences = false;
+		for (int32 Index = 0; Index < Schema.Properties.Num(); ++Index)
+		{
+			if (PresentProperties[Index])
+				continue;
+
+			FProperty* Property = Schema.Properties[Index].Property;
+			Property->CopyCompleteValue_InContainer(Object, Archetype);
+			bCopiedInstancedReferences |= Property->ContainsInstancedObjectProperty();
+		}
+
+		// The copied instanced references point to the sub objects of the archetype: the object gets its own instances
+		if (bCopiedInstancedReferences)
+			Object->InstanceSubobjectTemplates();
+	}
+
+	// Serialize JsonObject into a single line (for newline-delimited json stream)
+	FString SerializeJsonCondensed(const TSharedRef<FJsonObject>& InJsonObject)
+	{
+		FString SerializedJson;
+		FJsonSerializer::Serialize(InJsonObject, TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&SerializedJson));
+		return SerializedJson;
+	}
+
+	// Release the packages and everything loaded with them
+	void CollectGarbageForPackages(const TArray<UPackage*>& Packages)
+	{
+		// Loaded assets are RF_Standalone in the editor, so GARBAGE_COLLECTION_KEEPFLAGS would keep them all
+		for (UPackage* Package : Packages)
+		{
+			if (!Package)
+				continue;
+
+			ForEachObjectWithPackage(Package, [](UObject* Object)
+			{
+				Object->ClearFlags(RF_Standalone);
+				return true;
+			});
+			Package->ClearFlags(RF_Standalone);
+		}
+		// The same as ResavePackages: only the rooted and referenced objects are kept
+		CollectGarbage(RF_NoFlags);
+	}
+}
@@ -0,0 +1,76 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "CustomImportCallbackCommandlet.generated.h"
+
+
+DEFINE_LOG_CATEGORY_STATIC(LogDemoJsonCallback, Log, All);
+/**
+ * 
+ */
+UCLASS()
+class UE4CONTRIBUTIONCASESEDITOR_API UCustomImportCallbackCommandlet : public UCommandlet
+{
+public:
+	UCustomImportCallbackCommandlet(const FObjectInitializer& ObjectInitializer);
+	
+	virtual int32 Main(const FString& Params) override;
+
+	TSharedPtr<FJsonObject> ExportCase(const FString& InReferenceString);
+	void ImportCase(const FString& InReferenceString, const FString& InOpenFilePath);
+
+	// Export of all assets matched by "-Paths=/Game/...,/Game/..." and/or "-Class=SomeDataAsset".
+	// Assets are loaded on the game thread in batches, property-to-json conversion of a batch runs on worker threads.
+	// With "-AsyncDepth=N" packages are loaded asynchronously, N at once, and converted as soon as they are loaded.
+	// With "-LinkerExport" the records are read from the package files on the game thread, only the assets which need it are loaded.
+	// Output: one file per asset into "-OutputDir=" (default "%ProjectSavedDir%/BulkExport")
+	// or a single newline-delimited json stream into "-OutputFile=", or a bundle with the index into "-OutputBundle=".
+	int32 BulkExportCase(const FString& Params);
+
+	// Import of the exported assets from all "*.json" and "*.jsonb" files in "-ImportDir=" (recursive)
+	// or from the newline-delimited json stream "-ImportFile=", or from the bundle "-ImportBundle=" (only the records
+	// of "-Assets=" if set). Each record is applied to the asset from its "AssetRef" field.
+	// Files are parsed and validated on worker threads, properties are applied on the game thread.
+	// Dirty packages are saved by one SavePackages call at the end, or by chunks of "-SaveChunk=" packages.
+	// "-Validate" - dry run: all problems of the records are reported, nothing is loaded or saved.
+	int32 BatchImportCase(const FString& Params);
+
+	// Conversion between json and binary interchange format:
+	// "-ConvertToBinary=<file.json>" or "-ConvertToJson=<file.jsonb>", result into "-Output=" (default - the same name with the other extension).
+	// "-ConvertToBundle=<file.json>" makes a bundle from the json array of asset records
+	int32 ConvertCase(const FString& Params);
+
+	// Export without intermediate json tree: properties are written straight into the file as UTF-8 ("-Streaming")
+	void StreamExportCase(const FString& InReferenceString, const FString& InSaveFilePath);
+	// Import without FJsonValue tree: json tokens are written straight into the properties ("-Streaming")
+	void StreamImportCase(const FString& InReferenceString, const FString& InOpenFilePath);
+
+	void SaveToJsonFile(const TSharedPtr<FJsonObject> InJsonObject, const FString& InSaveFilePath);
+	FString SerializeJson(const TSharedPtr<FJsonObject> InJsonObject);
+
+	// Print the summary of FJsonConverterStats and append it to "-StatsCsv=" (default "%ProjectSavedDir%/JsonConverterStats.csv")
+	void ReportStats(const FString& Params, const FString& InMode) const;
+
+	// Log json payload, capped by MaxLoggedPayloadLen
+	void LogPayload(const FString& InPayload) const;
+	void LogPayloadFile(const FString& InFilePath) const;
+
+	// Log exported json payload ("-NoLogPayload" to disable)
+	bool bLogPayload = true;
+	// Maximum number of logged characters of json payload ("-LogPayloadLimit=")
+	int32 MaxLoggedPayloadLen = 16 * 1024;
+	// Write object references through the table of unique classes and packages ("-InternRefs", see FJsonReferenceTable)
+	bool bInternReferences = false;
+	// Export instanced sub objects once each into the object table of the record ("-ObjectGraph", see FJsonObjectGraph)
+	bool bObjectGraph = false;
+	// Read the asset properties from the package file, without loading the asset and its references ("-LinkerExport", see FJsonLinkerExport)
+	bool bLinkerExport = false;
+	
+
+	GENERATED_BODY()	
+};
+
+
@@ -0,0 +1,87 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+
+// Helpers shared by the export/import paths of UCustomImportCallbackCommandlet
+namespace FCustomCallbacksDemoLocal
+{
+	// Additional custom property name for custom json data
+	static const FString CustomAdditionalPropertyName = TEXT("SubObjectRef");
+
+	// Additional property name with the reference on exported asset (as in "ExampleCustomData/*.json")
+	static const FString AssetRefPropertyName = TEXT("AssetRef");
+	// Marker of the object exported in delta mode: missing properties have the values of the archetype
+	static const FString DeltaFieldName = TEXT("$Delta");
+	// Additional fields of the asset record are not properties
+	inline bool IsRecordMetadataField(const FString& InFieldName)
+	{
+		return InFieldName == AssetRefPropertyName || InFieldName == DeltaFieldName;
+	}
+
+	// Export only the properties which differ from the archetype: CDO, or the template of the instanced object ("-Delta")
+	void SetExportDelta(bool bInExportDelta);
+	bool IsExportDelta();
+
+	// Load data from json file
+	TSharedPtr<FJsonValue> LoadJsonFile(FString const& FilePath);
+	
+	// FPackageName::SplitFullObjectPath(StringValue, ClassName, PackagePath, ObjectName, SubObjectName);
+	// TODO: https://github.com/EpicGames/UnrealEngine/pull/7371
+	void CustomSplitFullObjectPath(const FString& InFullObjectPath, FString& OutClassName, FString& OutPackageName, FString& OutObjectName, FString& OutSubObjectName);
+
+	// Textual reference of the object property value. If the value is an instanced (sub) object, returns this object,
+	// otherwise returns nullptr and the value must be exported as the string reference.
+	// Instanced object which is not in memory can't be loaded on worker threads: returns nullptr and sets OutError
+	UObject* ResolveInstancedSubObject(FProperty* Property, const void* Value, FString& OutReferenceString, FString& OutError);
+
+	// Json of the object reference: instanced (sub) object as json object with "SubObjectRef", otherwise the string reference
+	TSharedPtr<FJsonValue> ObjectToJsonValue(const UObject* Object);
+
+	// Object of the json value written by ObjectToJsonValue (instanced sub object is created or updated).
+	// Returns false if the object is not resolved or the properties of the sub object are not fully imported
+	bool JsonValueToObject(const TSharedPtr<FJsonValue>& JsonValue, UObject*& OutObject);
+
+	// JsonValueToObject for the property of PropertyClass: the object is assigned to InOutObject only if it is of this class.
+	// Shared by the reflection and the typed import, so both restore the instanced objects the same way
+	bool JsonValueToObjectOfClass(const TSharedPtr<FJsonValue>& JsonValue, const UClass* PropertyClass, UObject*& InOutObject);
+
+	// Restore the property value from json: object references through FObjectImportReferenceCache, instanced objects
+	// (also inside arrays and structs) by JsonValueToObjectOfClass, other values by FJsonObjectConverter.
+	// Returns false if the value is not fully imported
+	bool ImportPropertyValue(FProperty* Property, const TSharedPtr<FJsonValue>& JsonValue, void* OutValue);
+
+	// Implementation for CustomExportCallback (Example of use)
+	TSharedPtr<FJsonValue> ObjectJsonCallback(FProperty* Property, const void* Value);
+
+	// Create instanced (sub) object by its textual reference "Class'/Package.Object:SubObject'".
+	// Existing sub object with the same name and class is reused, otherwise a new one is created with the original name.
+	// Returns nullptr if the reference does not contain sub object name
+	UObject* CreateInstancedSubObject(const FString& SubObjectRef);
+
+	// Implementation for my CustomImportCallback (Example of use)
+	bool JsonToObjectCallback(const TSharedPtr<FJsonValue>& JsonValue, FProperty* Property , void* OutValue);
+
+	// Convert all properties of the object into fields of JsonObject (using ObjectJsonCallback for object properties).
+	// In delta mode only the properties different from the archetype, and the "$Delta" marker
+	void ExportObjectProperties(const UObject* Object, const TSharedRef<FJsonObject>& OutJsonObject);
+
+	// Restore properties of the object from fields of JsonObject ("AssetRef" is skipped).
+	// Properties missing in the "$Delta" object are reset to the values of the archetype.
+	// Returns false if some fields don't match the properties of the object class or their values are not imported
+	bool ImportObjectProperties(UObject* Object, const TSharedRef<FJsonObject>& InJsonObject);
+
+	// Reset the properties of the "$Delta" object which are not present in json (indices of FPropertySchema::Properties)
+	// to the values of the archetype. Instanced sub objects of the archetype are instanced into the object, not shared
+	void ResetMissingPropertiesToArchetype(UObject* Object, const TBitArray<>& PresentProperties);
+
+	// Serialize JsonObject into a single line (for newline-delimited json stream)
+	FString SerializeJsonCondensed(const TSharedRef<FJsonObject>& InJsonObject);
+
+	// Clear RF_Standalone of all objects in the packages and collect garbage without keep flags, so the loaded packages
+	// are released (GARBAGE_COLLECTION_KEEPFLAGS keeps all loaded assets in the editor). Game thread only
+	void CollectGarbageForPackages(const TArray<UPackage*>& Packages);
+}
@@ -0,0 +1,211 @@
+#include "ExportManifest.h"
+
+#include "CustomJsonCallbacks.h"
+#include "PropertySchemaCache.h"
+#include "Misc/FileHelper.h"
+#include "Policies/PrettyJsonPrintPolicy.h"
+#include "Serialization/JsonSerializer.h"
+#include "UObject/UObjectHash.h"
+
+namespace FExportManifestLocal
+{
+	// Version of the exported data format. Increase it to invalidate all manifests
+	static const int32 ExportFormatVersion = 3;
+
+	// Classes of the instanced objects which can be stored in the property (directly or in containers)
+	void GetInstancedClasses(const FProperty* Property, TArray<const UStruct*>& OutStructs)
+	{
+		if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+			Property = ArrayProperty->Inner;
+		else if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+			Property = SetProperty->ElementProp;
+		else if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+			Property = MapProperty->ValueProp;
+
+		if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+		{
+			OutStructs.Add(StructProperty->Struct);
+			return;
+		}
+
+		const FObjectProperty* ObjectProperty = CastField<FObjectProperty>(Property);
+		if (!ObjectProperty || !ObjectProperty->HasAnyPropertyFlags(CPF_InstancedReference) || !ObjectProperty->PropertyClass)
+			return;
+
+		// Instanced object can be of any derived class (in the same order on each run)
+		TArray<UClass*> DerivedClasses;
+		GetDerivedClasses(ObjectProperty->PropertyClass, DerivedClasses);
+		DerivedClasses.Sort([](const UClass& A, const UClass& B) { return A.GetPathName() < B.GetPathName(); });
+		OutStructs.Add(ObjectProperty->PropertyClass);
+		OutStructs.Append(DerivedClasses);
+	}
+}
+
+FString FExportManifest::GetDefaultFilePath()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("BulkExportManifest.json"));
+}
+
+FString FExportManifest::GetFileState(const FString& InFilePath)
+{
+	const FFileStatData StatData = IFileManager::Get().GetStatData(*InFilePath);
+	if (!StatData.bIsValid || StatData.bIsDirectory)
+		return FString();
+	return FString::Printf(TEXT("%s/%lld"), *StatData.ModificationTime.ToIso8601(), StatData.FileSize);
+}
+
+bool FExportManifest::Load(const FString& InFilePath, const FString& InOptions)
+{
+	Entries.Reset();
+	Options = InOptions;
+
+	const TSharedPtr<FJsonValue> JsonFile = FCustomCallbacksDemoLocal::LoadJsonFile(InFilePath);
+	const TSharedPtr<FJsonObject>* JsonManifest;
+	if (!JsonFile.IsValid() || !JsonFile->TryGetObject(JsonManifest))
+		return false;
+
+	// The whole manifest is outdated with the other format version
+	if ((*JsonManifest)->GetIntegerField(TEXT("Version")) != FExportManifestLocal::ExportFormatVersion)
+		return false;
+	// ... and with the other output options
+	FString ManifestOptions;
+	if (!(*JsonManifest)->TryGetStringField(TEXT("Options"), ManifestOptions) || ManifestOptions != Options)
+		return false;
+
+	const TSharedPtr<FJsonObject>* JsonPackages;
+	if (!(*JsonManifest)->TryGetObjectField(TEXT("Packages"), JsonPackages))
+		return false;
+
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& JsonPackage : (*JsonPackages)->Values)
+	{
+		const TSharedPtr<FJsonObject>* JsonEntry;
+		if (!JsonPackage.Value->TryGetObject(JsonEntry))
+			continue;
+
+		FEntry& Entry = Entries.Add(*JsonPackage.Key);
+		Entry.SourceHash = (*JsonEntry)->GetStringField(TEXT("SourceHash"));
+		Entry.SchemaHash = static_cast<uint32>((*JsonEntry)->GetNumberField(TEXT("SchemaHash")));
+		Entry.OutputFile = (*JsonEntry)->GetStringField(TEXT("OutputFile"));
+		Entry.OutputState = (*JsonEntry)->GetStringField(TEXT("OutputState"));
+		Entry.OutputHash = (*JsonEntry)->GetStringField(TEXT("OutputHash"));
+	}
+	return true;
+}
+
+bool FExportManifest::Save(const FString& InFilePath) const
+{
+	TSharedRef<FJsonObject> JsonPackages = MakeShared<FJsonObject>();
+	for (const TPair<FName, FEntry>& Entry : Entries)
+	{
+		TSharedRef<FJsonObject> JsonEntry = MakeShared<FJsonObject>();
+		JsonEntry->SetStringField(TEXT("SourceHash"), Entry.Value.SourceHash);
+		JsonEntry->SetNumberField(TEXT("SchemaHash"), Entry.Value.SchemaHash);
+		JsonEntry->SetStringField(TEXT("OutputFile"), Entry.Value.OutputFile);
+		JsonEntry->SetStringField(TEXT("OutputState"), Entry.Value.OutputState);
+		JsonEntry->SetStringField(TEXT("OutputHash"), Entry.Value.OutputHash);
+		JsonPackages->SetObjectField(Entry.Key.ToString(), JsonEntry);
+	}
+
+	TSharedRef<FJsonObject> JsonManifest = MakeShared<FJsonObject>();
+	JsonManifest->SetNumberField(TEXT("Version"), FExportManifestLocal::ExportFormatVersion);
+	JsonManifest->SetStringField(TEXT("Options"), Options);
+	JsonManifest->SetObjectField(TEXT("Packages"), JsonPackages);
+
+	FString SerializedJson;
+	FJsonSerializer::Serialize(JsonManifest, TJsonWriterFactory<>::Create(&SerializedJson));
+	return FFileHelper::SaveStringToFile(SerializedJson, *InFilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+}
+
+bool FExportManifest::MakeEntry(const FName& InPackageName, const UClass* InAssetClass, bool bHashSourceContent, FEntry& OutEntry)
+{
+	FString PackageFileName;
+	if (!FPackageName::DoesPackageExist(InPackageName.ToString(), nullptr, &PackageFileName))
+		return false;
+
+	if (bHashSourceContent)
+	{
+		OutEntry.SourceHash = LexToString(FMD5Hash::HashFile(*PackageFileName));
+	}
+	else
+	{
+		OutEntry.SourceHash = GetFileState(PackageFileName);
+		if (OutEntry.SourceHash.IsEmpty())
+			return false;
+	}
+
+	// Asset class is not known without loading (for example, blueprint class), so the package is always exported
+	OutEntry.SchemaHash = InAssetClass ? GetReachableSchemaHash(InAssetClass) : 0;
+	return InAssetClass != nullptr;
+}
+
+bool FExportManifest::IsOutdated(const FName& InPackageName, const FEntry& InCurrentEntry)
+{
+	FEntry* Entry = Entries.Find(InPackageName);
+	if (!Entry || !(*Entry == InCurrentEntry))
+		return true;
+
+	// Output file is missing, or changed after the export. The file with the same timestamp and size is not read
+	const FString OutputState = GetFileState(Entry->OutputFile);
+	if (OutputState.IsEmpty())
+		return true;
+	if (OutputState == Entry->OutputState)
+		return false;
+	if (LexToString(FMD5Hash::HashFile(*Entry->OutputFile)) != Entry->OutputHash)
+		return true;
+
+	// Same content with the other timestamp (e.g. copied): it is not hashed again on the next run
+	Entry->OutputState = OutputState;
+	return false;
+}
+
+int32 FExportManifest::PruneRemovedPackages()
+{
+	int32 NumRemoved = 0;
+	for (auto It = Entries.CreateIterator(); It; ++It)
+	{
+		if (FPackageName::DoesPackageExist(It.Key().ToString()))
+			continue;
+
+		IFileManager::Get().Delete(*It.Value().OutputFile, false, false, true);
+		It.RemoveCurrent();
+		++NumRemoved;
+	}
+	return NumRemoved;
+}
+
+uint32 FExportManifest::GetReachableSchemaHash(const UClass* InClass)
+{
+	if (const uint32* Hash = ReachableSchemaHashes.Find(InClass))
+		return *Hash;
+
+	// Schema hash covers the nested structs, but not the classes of the instanced objects inside them
+	uint32 Hash = 0;
+	TSet<const UStruct*> EncounteredStructs;
+	TArray<const UStruct*> PendingStructs = { InClass };
+	while (PendingStructs.Num() > 0)
+	{
+		const UStruct* Struct = PendingStructs.Pop(false);
+		bool bAlreadyEncountered = false;
+		EncounteredStructs.Add(Struct, &bAlreadyEncountered);
+		if (bAlreadyEncountered)
+			continue;
+
+		const FPropertySchema& Schema = FPropertySchemaCache::Get().GetSchema(Struct);
+		Hash = HashCombine(Hash, Schema.SchemaHash);
+
+		// Reversed, so the structs are visited in the order of the properties
+		TArray<const UStruct*> ReachableStructs;
+		for (const FCachedProperty& CachedProperty : Schema.Properties)
+			FExportManifestLocal::GetInstancedClasses(CachedProperty.Property, ReachableStructs);
+		for (int32 Index = ReachableStructs.Num() - 1; Index >= 0; --Index)
+			PendingStructs.Add(ReachableStructs[Index]);
+	}
+
+	ReachableSchemaHashes.Add(InClass, Hash);
+	return Hash;
+}
+
+void FExportManifest::SetEntry(const FName& InPackageName, const FEntry& InEntry)
+{
+	Entries.Add(InPackageName, InEntry);
+}
@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+/**
+ * Manifest of the incremental bulk export ("%ProjectSavedDir%/BulkExportManifest.json").
+ * For each exported package it keeps the state of the source package file, the schema hash of the asset class
+ * and the hash of the output file. The options which change the output are kept for the whole manifest.
+ * Packages with unchanged source, schema and output are skipped without loading.
+ */
+class FExportManifest
+{
+public:
+	struct FEntry
+	{
+		// Timestamp and size of the package file, or MD5 of its content ("-HashSources")
+		FString SourceHash;
+		// FPropertySchema::SchemaHash of the asset class and of the instanced classes reachable from it
+		uint32 SchemaHash = 0;
+		FString OutputFile;
+		// Timestamp and size of the output file: the output is hashed only if they have changed
+		FString OutputState;
+		// MD5 of the output file
+		FString OutputHash;
+
+		bool operator==(const FEntry& Other) const
+		{
+			return SourceHash == Other.SourceHash && SchemaHash == Other.SchemaHash && OutputFile == Other.OutputFile;
+		}
+	};
+
+	static FString GetDefaultFilePath();
+	// Timestamp and size of the file, empty if the file is not found
+	static FString GetFileState(const FString& InFilePath);
+
+	// Load the entries. InOptions - the export options which change the output ("-Delta", "-InternRefs" etc.):
+	// the manifest written with the other options is outdated as a whole. Returns false if the manifest is outdated or not found
+	bool Load(const FString& InFilePath, const FString& InOptions);
+	bool Save(const FString& InFilePath) const;
+
+	// Entry of the current state of the package (no loading of the package). Returns false if the package file is not found
+	bool MakeEntry(const FName& InPackageName, const UClass* InAssetClass, bool bHashSourceContent, FEntry& OutEntry);
+
+	// Whether the package must be exported again: there is no entry, source or schema has changed,
+	// or the output file is missing or differs from the exported one (MD5 is compared only if its timestamp or size
+	// has changed, the state of the same content is updated)
+	bool IsOutdated(const FName& InPackageName, const FEntry& InCurrentEntry);
+
+	// Remove the entries of the packages which no longer exist, and their output files. Returns the number of entries
+	int32 PruneRemovedPackages();
+
+	void SetEntry(const FName& InPackageName, const FEntry& InEntry);
+
+private:
+	// Hash of the schemas of the class, of its structs and of the classes of its instanced objects (with derived classes)
+	uint32 GetReachableSchemaHash(const UClass* InClass);
+
+	FString Options;
+	TMap<FName, FEntry> Entries;
+	// Hashes of the reachable schemas by class, computed once per run
+	TMap<FObjectKey, uint32> ReachableSchemaHashes;
+};
@@ -0,0 +1,228 @@
+#include "JsonArenaDocument.h"
+
+#include "Serialization/JsonReader.h"
+
+namespace FJsonArenaDocumentLocal
+{
+	// Field names of maps are data, so the interned names are dropped when there are too many of them
+	constexpr int32 MaxKeptKeys = 64 * 1024;
+}
+
+bool FJsonArenaDocument::Parse(const FString& InJsonText)
+{
+	Reset();
+
+	struct FOpenContainer
+	{
+		int32 NodeIndex;
+		int32 ScratchStart;
+	};
+	TArray<FOpenContainer, TInlineAllocator<32>> OpenContainers;
+
+	const TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(InJsonText);
+	EJsonNotation Notation;
+	while (JsonReader->ReadNext(Notation))
+	{
+		if (Notation == EJsonNotation::ObjectEnd || Notation == EJsonNotation::ArrayEnd)
+		{
+			const FOpenContainer OpenContainer = OpenContainers.Pop(false);
+			CloseContainer(OpenContainer.NodeIndex, OpenContainer.ScratchStart);
+			continue;
+		}
+		if (Notation == EJsonNotation::Error)
+			break;
+
+		const bool bInObject = OpenContainers.Num() > 0 && Nodes[OpenContainers.Last().NodeIndex].Type == EJson::Object;
+		const int32 Key = bInObject ? InternKey(JsonReader->GetIdentifier()) : INDEX_NONE;
+
+		int32 NodeIndex = INDEX_NONE;
+		switch (Notation)
+		{
+		case EJsonNotation::ObjectStart:
+		case EJsonNotation::ArrayStart:
+			NodeIndex = AddNode(Notation == EJsonNotation::ObjectStart ? EJson::Object : EJson::Array, Key);
+			break;
+		case EJsonNotation::String:
+			NodeIndex = AddString(Key, JsonReader->GetValueAsString());
+			break;
+		case EJsonNotation::Number:
+			NodeIndex = AddNode(EJson::Number, Key);
+			Nodes[NodeIndex].Number = JsonReader->GetValueAsNumber();
+			break;
+		case EJsonNotation::Boolean:
+			NodeIndex = AddNode(EJson::Boolean, Key);
+			Nodes[NodeIndex].bBoolean = JsonReader->GetValueAsBoolean();
+			break;
+		case EJsonNotation::Null:
+			NodeIndex = AddNode(EJson::Null, Key);
+			break;
+		default:
+			break;
+		}
+
+		if (OpenContainers.Num() > 0)
+			Scratch.Add(NodeIndex);
+		if (Notation == EJsonNotation::ObjectStart || Notation == EJsonNotation::ArrayStart)
+			OpenContainers.Add({NodeIndex, Scratch.Num()});
+	}
+
+	ErrorMessage = JsonReader->GetErrorMessage();
+	if (ErrorMessage.IsEmpty() && (Nodes.Num() == 0 || OpenContainers.Num() > 0))
+		ErrorMessage = TEXT("Unexpected end of json");
+	return ErrorMessage.IsEmpty();
+}
+
+void FJsonArenaDocument::FromJsonValue(const TSharedPtr<FJsonValue>& InJsonValue)
+{
+	Reset();
+	if (InJsonValue.IsValid())
+		AddJsonValue(InJsonValue, INDEX_NONE);
+}
+
+int32 FJsonArenaDocument::AddJsonValue(const TSharedPtr<FJsonValue>& InJsonValue, int32 Key)
+{
+	switch (InJsonValue->Type)
+	{
+	case EJson::String:
+		return AddString(Key, InJsonValue->AsString());
+	case EJson::Number:
+	{
+		const int32 NodeIndex = AddNode(EJson::Number, Key);
+		Nodes[NodeIndex].Number = InJsonValue->AsNumber();
+		return NodeIndex;
+	}
+	case EJson::Boolean:
+	{
+		const int32 NodeIndex = AddNode(EJson::Boolean, Key);
+		Nodes[NodeIndex].bBoolean = InJsonValue->AsBool();
+		return NodeIndex;
+	}
+	case EJson::Array:
+	{
+		const int32 NodeIndex = AddNode(EJson::Array, Key);
+		const int32 ScratchStart = Scratch.Num();
+		for (const TSharedPtr<FJsonValue>& JsonElement : InJsonValue->AsArray())
+		{
+			const int32 ElementIndex = AddJsonValue(JsonElement, INDEX_NONE);
+			Scratch.Add(ElementIndex);
+		}
+		CloseContainer(NodeIndex, ScratchStart);
+		return NodeIndex;
+	}
+	case EJson::Object:
+	{
+		const int32 NodeIndex = AddNode(EJson::Object, Key);
+		const int32 ScratchStart = Scratch.Num();
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& JsonField : InJsonValue->AsObject()->Values)
+		{
+			const int32 FieldIndex = AddJsonValue(JsonField.Value, InternKey(JsonField.Key));
+			Scratch.Add(FieldIndex);
+		}
+		CloseContainer(NodeIndex, ScratchStart);
+		return NodeIndex;
+	}
+	default:
+		return AddNode(EJson::Null, Key);
+	}
+}
+
+TSharedPtr<FJsonValue> FJsonArenaDocument::ToJsonValue(int32 NodeIndex) const
+{
+	const FJsonArenaNode& Node = Nodes[NodeIndex];
+	switch (Node.Type)
+	{
+	case EJson::String:
+	{
+		const FStringView Value = GetString(NodeIndex);
+		return MakeShared<FJsonValueString>(FString(Value.Len(), Value.GetData()));
+	}
+	case EJson::Number:
+		return MakeShared<FJsonValueNumber>(Node.Number);
+	case EJson::Boolean:
+		return MakeShared<FJsonValueBoolean>(Node.bBoolean);
+	case EJson::Array:
+	{
+		TArray<TSharedPtr<FJsonValue>> JsonElements;
+		JsonElements.Reserve(Node.Num);
+		for (const int32 ChildIndex : GetChildren(NodeIndex))
+			JsonElements.Add(ToJsonValue(ChildIndex));
+		return MakeShared<FJsonValueArray>(JsonElements);
+	}
+	case EJson::Object:
+	{
+		const TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+		for (const int32 ChildIndex : GetChildren(NodeIndex))
+			JsonObject->SetField(GetKey(ChildIndex), ToJsonValue(ChildIndex));
+		return MakeShared<FJsonValueObject>(JsonObject);
+	}
+	default:
+		return MakeShared<FJsonValueNull>();
+	}
+}
+
+void FJsonArenaDocument::Reset()
+{
+	Nodes.Reset();
+	ChildIndices.Reset();
+	StringData.Reset();
+	Scratch.Reset();
+	ErrorMessage.Reset();
+
+	if (Keys.Num() > FJsonArenaDocumentLocal::MaxKeptKeys)
+	{
+		Keys.Reset();
+		KeyIndices.Reset();
+	}
+}
+
+int32 FJsonArenaDocument::FindField(int32 ObjectIndex, const FString& InKey) const
+{
+	const TArrayView<const int32> Children = GetChildren(ObjectIndex);
+	for (int32 Index = Children.Num() - 1; Index >= 0; --Index)
+	{
+		if (Keys[Nodes[Children[Index]].Key].Equals(InKey, ESearchCase::IgnoreCase))
+			return Children[Index];
+	}
+	return INDEX_NONE;
+}
+
+SIZE_T FJsonArenaDocument::GetAllocatedSize() const
+{
+	SIZE_T Size = Nodes.GetAllocatedSize() + ChildIndices.GetAllocatedSize() + StringData.GetAllocatedSize() + Scratch.GetAllocatedSize()
+		+ Keys.GetAllocatedSize() + KeyIndices.GetAllocatedSize();
+	for (const FString& Key : Keys)
+		Size += Key.GetAllocatedSize();
+	return Size;
+}
+
+int32 FJsonArenaDocument::AddNode(EJson Type, int32 Key)
+{
+	const int32 NodeIndex = Nodes.AddDefaulted();
+	Nodes[NodeIndex].Type = Type;
+	Nodes[NodeIndex].Key = Key;
+	return NodeIndex;
+}
+
+int32 FJsonArenaDocument::AddString(int32 Key, const FString& InValue)
+{
+	const int32 NodeIndex = AddNode(EJson::String, Key);
+	Nodes[NodeIndex].Offset = StringData.Num();
+	Nodes[NodeIndex].Num = InValue.Len();
+	StringData.Append(*InValue, InValue.Len());
+	return NodeIndex;
+}
+
+int32 FJsonArenaDocument::InternKey(const FString& InKey)
+{
+	if (const int32* Key = KeyIndices.Find(InKey))
+		return *Key;
+	return KeyIndices.Add(InKey, Keys.Add(InKey));
+}
+
+void FJsonArenaDocument::CloseContainer(int32 NodeIndex, int32 ScratchStart)
+{
+	Nodes[NodeIndex].Offset = ChildIndices.Num();
+	Nodes[NodeIndex].Num = Scratch.Num() - ScratchStart;
+	ChildIndices.Append(Scratch.GetData() + ScratchStart, Scratch.Num() - ScratchStart);
+	Scratch.SetNum(ScratchStart, false);
+}
@@ -0,0 +1,95 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+
+// One value of FJsonArenaDocument
+struct FJsonArenaNode
+{
+	EJson Type = EJson::None;
+	bool bBoolean = false;
+	// Interned name of the object field, INDEX_NONE for array elements and the root
+	int32 Key = INDEX_NONE;
+	// String - range of the string buffer, Array/Object - range of the child index list
+	int32 Offset = 0;
+	int32 Num = 0;
+	double Number = 0.0;
+};
+
+/**
+ * Read-only json document in contiguous storage: all values are nodes of one array, strings are slices of one
+ * character buffer, children of the containers are ranges of one index list, field names are interned once.
+ * Reset keeps the capacity, so a document reused for a stream of records stops allocating after the first ones,
+ * instead of a TSharedPtr<FJsonValue>/FJsonObject allocation with a TMap per value.
+ * Adapters convert from and to FJsonValue for the code which needs the FJsonObject API.
+ */
+class FJsonArenaDocument
+{
+public:
+	static constexpr int32 RootIndex = 0;
+
+	// Parse the json text, the previous content is dropped. Returns false on syntax error (see GetErrorMessage)
+	bool Parse(const FString& InJsonText);
+	// Copy of the json value tree, the previous content is dropped
+	void FromJsonValue(const TSharedPtr<FJsonValue>& InJsonValue);
+	// FJsonValue tree of the node (and its children)
+	TSharedPtr<FJsonValue> ToJsonValue(int32 NodeIndex = RootIndex) const;
+
+	// Drop the content, the memory is kept for the next document
+	void Reset();
+
+	bool IsEmpty() const { return Nodes.Num() == 0; }
+	const FString& GetErrorMessage() const { return ErrorMessage; }
+
+	const FJsonArenaNode& GetNode(int32 NodeIndex) const { return Nodes[NodeIndex]; }
+	TArrayView<const int32> GetChildren(int32 NodeIndex) const
+	{
+		const FJsonArenaNode& Node = Nodes[NodeIndex];
+		return (Node.Type == EJson::Object || Node.Type == EJson::Array) ? TArrayView<const int32>(ChildIndices.GetData() + Node.Offset, Node.Num) : TArrayView<const int32>();
+	}
+	// Field name of the node in its object
+	const FString& GetKey(int32 NodeIndex) const { return Keys[Nodes[NodeIndex].Key]; }
+	FStringView GetString(int32 NodeIndex) const
+	{
+		const FJsonArenaNode& Node = Nodes[NodeIndex];
+		return Node.Type == EJson::String ? FStringView(StringData.GetData() + Node.Offset, Node.Num) : FStringView();
+	}
+
+	// Index of the field of the object node, INDEX_NONE if not found. Names are compared case-insensitive, as FJsonObject does.
+	// The last field wins if the name is repeated, as in FJsonObject
+	int32 FindField(int32 ObjectIndex, const FString& InKey) const;
+
+	// Memory held by the document, including the capacity kept by Reset
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	int32 AddNode(EJson Type, int32 Key);
+	int32 AddString(int32 Key, const FString& InValue);
+	int32 InternKey(const FString& InKey);
+	// Move the children collected since ScratchStart into the child index list of the container node
+	void CloseContainer(int32 NodeIndex, int32 ScratchStart);
+	int32 AddJsonValue(const TSharedPtr<FJsonValue>& InJsonValue, int32 Key);
+
+	TArray<FJsonArenaNode> Nodes;
+	TArray<int32> ChildIndices;
+	TArray<TCHAR> StringData;
+	// Children of the open containers while the document is built
+	TArray<int32> Scratch;
+
+	// Names are interned as written, the adapters keep the original case
+	struct FCaseSensitiveKeyFuncs : BaseKeyFuncs<TPair<FString, int32>, FString, false>
+	{
+		static const FString& GetSetKey(const TPair<FString, int32>& Element) { return Element.Key; }
+		static bool Matches(const FString& A, const FString& B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+		static uint32 GetKeyHash(const FString& Key) { return FCrc::StrCrc32(*Key); }
+	};
+
+	// Interned field names are kept by Reset (the records of one stream have the same names)
+	TArray<FString> Keys;
+	TMap<FString, int32, FDefaultSetAllocator, FCaseSensitiveKeyFuncs> KeyIndices;
+
+	FString ErrorMessage;
+};
@@ -0,0 +1,161 @@
+#include "JsonAssetBundle.h"
+
+#include "CustomImportCallbackCommandlet.h"
+#include "CustomJsonCallbacks.h"
+#include "JsonConverterStats.h"
+
+namespace FJsonAssetBundleLocal
+{
+	static const uint32 Magic = 0x584A4355; // "UCJX"
+	static const int64 FooterSize = sizeof(int64) + sizeof(uint32);
+	// Index entry with the empty AssetRef: FString length, offset and length of the record
+	static const int64 MinIndexEntrySize = sizeof(int32) + sizeof(int64) + sizeof(int32);
+
+	// Read the footer, returns the index offset or INDEX_NONE
+	int64 ReadFooter(FArchive& Ar)
+	{
+		const int64 TotalSize = Ar.TotalSize();
+		if (TotalSize < FooterSize)
+			return INDEX_NONE;
+
+		int64 IndexOffset = 0;
+		uint32 FileMagic = 0;
+		Ar.Seek(TotalSize - FooterSize);
+		Ar << IndexOffset;
+		Ar << FileMagic;
+		if (Ar.IsError() || FileMagic != Magic || IndexOffset < 0 || IndexOffset > TotalSize - FooterSize)
+			return INDEX_NONE;
+		return IndexOffset;
+	}
+}
+
+namespace FJsonAssetBundle
+{
+	bool ConvertJsonToBundle(const FString& InJsonFilePath, const FString& InBundleFilePath)
+	{
+		using namespace FCustomCallbacksDemoLocal;
+
+		const TSharedPtr<FJsonValue> JsonFile = LoadJsonFile(InJsonFilePath);
+		const TArray<TSharedPtr<FJsonValue>>* JsonRecords;
+		if (!JsonFile.IsValid() || !JsonFile->TryGetArray(JsonRecords))
+			return false;
+
+		TUniquePtr<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*InBundleFilePath));
+		if (!FileWriter)
+			return false;
+
+		FJsonAssetBundleWriter BundleWriter(FileWriter.Get());
+		for (const TSharedPtr<FJsonValue>& JsonRecord : *JsonRecords)
+		{
+			const TSharedPtr<FJsonObject>* JsonObject;
+			FString AssetRef;
+			if (!JsonRecord->TryGetObject(JsonObject) || !(*JsonObject)->TryGetStringField(AssetRefPropertyName, AssetRef))
+			{
+				UE_LOG(LogDemoJsonCallback, Error, TEXT("Record without '%s' in '%s' skipped."), *AssetRefPropertyName, *InJsonFilePath);
+				continue;
+			}
+			if (!BundleWriter.AddRecord(AssetRef, SerializeJsonCondensed(JsonObject->ToSharedRef())))
+				UE_LOG(LogDemoJsonCallback, Error, TEXT("Duplicate record '%s' in '%s' skipped."), *AssetRef, *InJsonFilePath);
+		}
+		return BundleWriter.Close() && FileWriter->Close();
+	}
+}
+
+FJsonAssetBundleWriter::FJsonAssetBundleWriter(FArchive* InArchive)
+	: Archive(InArchive)
+{
+}
+
+bool FJsonAssetBundleWriter::AddRecord(const FString& InAssetRef, const FString& InSerializedJson)
+{
+	bool bAlreadyInBundle = false;
+	AssetRefs.Add(InAssetRef, &bAlreadyInBundle);
+	if (bAlreadyInBundle)
+		return false;
+
+	FTCHARToUTF8 Utf8Record(*InSerializedJson);
+	Index.Add({InAssetRef, Archive->Tell(), Utf8Record.Length()});
+	Archive->Serialize(const_cast<ANSICHAR*>(Utf8Record.Get()), Utf8Record.Length());
+
+	// Records are separated by lines, so the record part stays readable as newline-delimited json
+	ANSICHAR NewLine = '\n';
+	Archive->Serialize(&NewLine, 1);
+	JSON_CONVERTER_COUNT(BytesWritten, Utf8Record.Length() + 1);
+	return true;
+}
+
+bool FJsonAssetBundleWriter::Close()
+{
+	int64 IndexOffset = Archive->Tell();
+	int32 Count = Index.Num();
+	*Archive << Count;
+	for (FIndexEntry& Entry : Index)
+	{
+		*Archive << Entry.AssetRef;
+		*Archive << Entry.Offset;
+		*Archive << Entry.Length;
+	}
+
+	uint32 Magic = FJsonAssetBundleLocal::Magic;
+	*Archive << IndexOffset;
+	*Archive << Magic;
+	return !Archive->IsError();
+}
+
+bool FJsonAssetBundleReader::Open(const FString& InFilePath)
+{
+	AssetRefs.Reset();
+	RecordByAssetRef.Reset();
+
+	FileReader.Reset(IFileManager::Get().CreateFileReader(*InFilePath));
+	if (!FileReader)
+		return false;
+
+	const int64 IndexOffset = FJsonAssetBundleLocal::ReadFooter(*FileReader);
+	if (IndexOffset == INDEX_NONE)
+		return false;
+
+	// Only the index is read here
+	FileReader->Seek(IndexOffset);
+	int32 Count = 0;
+	*FileReader << Count;
+	// The count of the corrupted index must not reserve more entries than the index can hold
+	const int64 IndexSize = FileReader->TotalSize() - FJsonAssetBundleLocal::FooterSize - FileReader->Tell();
+	if (FileReader->IsError() || Count < 0 || Count > IndexSize / FJsonAssetBundleLocal::MinIndexEntrySize)
+		return false;
+
+	AssetRefs.Reserve(Count);
+	RecordByAssetRef.Reserve(Count);
+	for (int32 Index = 0; Index < Count && !FileReader->IsError(); ++Index)
+	{
+		FString AssetRef;
+		FRecordRange Range;
+		*FileReader << AssetRef;
+		*FileReader << Range.Offset;
+		*FileReader << Range.Length;
+		if (Range.Offset < 0 || Range.Length < 0 || Range.Offset + Range.Length > IndexOffset || RecordByAssetRef.Contains(AssetRef))
+			return false;
+
+		AssetRefs.Add(AssetRef);
+		RecordByAssetRef.Add(MoveTemp(AssetRef), Range);
+	}
+	return !FileReader->IsError();
+}
+
+bool FJsonAssetBundleReader::ReadRecord(const FString& InAssetRef, FString& OutJson)
+{
+	const FRecordRange* Range = RecordByAssetRef.Find(InAssetRef);
+	if (!Range || !FileReader)
+		return false;
+
+	RecordBuffer.SetNumUninitialized(Range->Length, false);
+	FileReader->Seek(Range->Offset);
+	FileReader->Serialize(RecordBuffer.GetData(), Range->Length);
+	if (FileReader->IsError())
+		return false;
+	JSON_CONVERTER_COUNT(BytesRead, Range->Length);
+
+	const FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(RecordBuffer.GetData()), RecordBuffer.Num());
+	OutJson = FString(Converter.Length(), Converter.Get());
+	return true;
+}
@@ -0,0 +1,72 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+
+/**
+ * Bundle of many exported asset records in one file, with the index for random access by "AssetRef".
+ *
+ * File: records as condensed UTF-8 json objects (one per line), then the index, then the fixed size footer.
+ * Index: int32 count, (AssetRef as FString, int64 offset, int32 length) per record.
+ * Footer: int64 index offset, uint32 "UCJX" magic.
+ * AssetRefs are unique: the writer rejects a duplicate record, the reader rejects a bundle with duplicates.
+ * Reader loads only the index, a record is read and parsed when it is requested.
+ */
+namespace FJsonAssetBundle
+{
+	static const FString FileExtension = TEXT(".jsonbundle");
+
+	// Make a bundle from the json array of records (as "ExampleCustomData/SomeDataAsset.json")
+	bool ConvertJsonToBundle(const FString& InJsonFilePath, const FString& InBundleFilePath);
+}
+
+class FJsonAssetBundleWriter
+{
+public:
+	explicit FJsonAssetBundleWriter(FArchive* InArchive);
+
+	// Append a record (condensed json of the asset object). Returns false if the bundle has the record of this AssetRef
+	bool AddRecord(const FString& InAssetRef, const FString& InSerializedJson);
+
+	// Write the index and the footer
+	bool Close();
+
+private:
+	struct FIndexEntry
+	{
+		FString AssetRef;
+		int64 Offset;
+		int32 Length;
+	};
+
+	FArchive* Archive;
+	TArray<FIndexEntry> Index;
+	TSet<FString> AssetRefs;
+};
+
+class FJsonAssetBundleReader
+{
+public:
+	bool Open(const FString& InFilePath);
+
+	// AssetRefs of all records in the order of the file
+	const TArray<FString>& GetAssetRefs() const { return AssetRefs; }
+	bool Contains(const FString& InAssetRef) const { return RecordByAssetRef.Contains(InAssetRef); }
+
+	// Read text of one record (seek and read of its bytes only). Not thread-safe
+	bool ReadRecord(const FString& InAssetRef, FString& OutJson);
+
+private:
+	struct FRecordRange
+	{
+		int64 Offset;
+		int32 Length;
+	};
+
+	TUniquePtr<FArchive> FileReader;
+	TArray<FString> AssetRefs;
+	TMap<FString, FRecordRange> RecordByAssetRef;
+	TArray<uint8> RecordBuffer;
+};
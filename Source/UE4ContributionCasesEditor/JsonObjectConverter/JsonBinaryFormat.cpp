@@ -0,0 +1,423 @@
+#include "JsonBinaryFormat.h"
+
+#include "CustomImportCallbackCommandlet.h"
+#include "CustomJsonCallbacks.h"
+#include "JsonConverterStats.h"
+#include "Misc/FileHelper.h"
+
+namespace FJsonBinaryFormatLocal
+{
+	static const uint32 Magic = 'U' | ('C' << 8) | ('J' << 16) | ('B' << 24);
+	// 1 - strings and keys inline, 2 - strings and keys are indices in the string table
+	static const uint16 Version = 2;
+	static const uint16 FirstStringTableVersion = 2;
+
+	// Upper limit of counts and lengths, protects from allocation of huge arrays on corrupted data
+	static const uint64 MaxLength = MAX_int32;
+	// Upper limit of nesting of arrays and objects, protects from the stack overflow on corrupted data
+	static const int32 MaxDepth = 256;
+
+	void WriteVarInt(FArchive& Ar, uint64 Value)
+	{
+		do
+		{
+			uint8 Byte = Value & 0x7F;
+			Value >>= 7;
+			if (Value != 0)
+				Byte |= 0x80;
+			Ar << Byte;
+		}
+		while (Value != 0);
+	}
+
+	uint64 ReadVarInt(FArchive& Ar)
+	{
+		uint64 Value = 0;
+		for (int32 Shift = 0; Shift < 64 && !Ar.IsError(); Shift += 7)
+		{
+			uint8 Byte = 0;
+			Ar << Byte;
+			Value |= uint64(Byte & 0x7F) << Shift;
+			if ((Byte & 0x80) == 0)
+				return Value;
+		}
+		Ar.SetError();
+		return 0;
+	}
+
+	void WriteString(FArchive& Ar, const FString& Value)
+	{
+		const FTCHARToUTF8 Utf8String(*Value);
+		WriteVarInt(Ar, Utf8String.Length());
+		Ar.Serialize(const_cast<ANSICHAR*>(Utf8String.Get()), Utf8String.Length());
+	}
+
+	bool ReadString(FArchive& Ar, FString& OutValue)
+	{
+		const uint64 Length = ReadVarInt(Ar);
+		if (Ar.IsError() || Length > MaxLength || int64(Length) > Ar.TotalSize() - Ar.Tell())
+			return false;
+
+		TArray<ANSICHAR> Utf8String;
+		Utf8String.SetNumUninitialized(static_cast<int32>(Length));
+		Ar.Serialize(Utf8String.GetData(), Length);
+
+		const FUTF8ToTCHAR Converter(Utf8String.GetData(), Utf8String.Num());
+		OutValue = FString(Converter.Length(), Converter.Get());
+		return !Ar.IsError();
+	}
+
+	// Containers are prefixed with the byte length, so it is patched after the content is written
+	int64 BeginLengthPrefix(FArchive& Ar)
+	{
+		const int64 LengthPos = Ar.Tell();
+		uint32 Length = 0;
+		Ar << Length;
+		return LengthPos;
+	}
+
+	void EndLengthPrefix(FArchive& Ar, int64 LengthPos)
+	{
+		const int64 EndPos = Ar.Tell();
+		uint32 Length = static_cast<uint32>(EndPos - LengthPos - sizeof(uint32));
+		Ar.Seek(LengthPos);
+		Ar << Length;
+		Ar.Seek(EndPos);
+	}
+
+	struct FCaseSensitiveKeyFuncs : BaseKeyFuncs<TPair<FString, int32>, FString, false>
+	{
+		static const FString& GetSetKey(const TPair<FString, int32>& Element) { return Element.Key; }
+		static bool Matches(const FString& A, const FString& B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+		static uint32 GetKeyHash(const FString& Key) { return FCrc::StrCrc32(*Key); }
+	};
+	using FStringIndices = TMap<FString, int32, FDefaultSetAllocator, FCaseSensitiveKeyFuncs>;
+
+	// Field names and string values are written once into the table, the values refer to them by index
+	void CollectStrings(const TSharedPtr<FJsonValue>& Value, FStringIndices& OutIndices)
+	{
+		if (!Value.IsValid())
+			return;
+
+		if (Value->Type == EJson::String)
+		{
+			OutIndices.FindOrAdd(Value->AsString(), OutIndices.Num());
+		}
+		else if (Value->Type == EJson::Array)
+		{
+			for (const TSharedPtr<FJsonValue>& Element : Value->AsArray())
+				CollectStrings(Element, OutIndices);
+		}
+		else if (Value->Type == EJson::Object)
+		{
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Value->AsObject()->Values)
+			{
+				OutIndices.FindOrAdd(Field.Key, OutIndices.Num());
+				CollectStrings(Field.Value, OutIndices);
+			}
+		}
+	}
+
+	void WriteValue(FArchive& Ar, const FStringIndices& Strings, const TSharedPtr<FJsonValue>& Value)
+	{
+		using namespace FJsonBinaryFormat;
+
+		auto WriteType = [&Ar](EValueType Type)
+		{
+			uint8 TypeByte = static_cast<uint8>(Type);
+			Ar << TypeByte;
+		};
+
+		if (!Value.IsValid())
+		{
+			WriteType(EValueType::Null);
+			return;
+		}
+
+		switch (Value->Type)
+		{
+		case EJson::Boolean:
+			WriteType(Value->AsBool() ? EValueType::True : EValueType::False);
+			break;
+
+		case EJson::Number:
+		{
+			// Typed scalars: integral numbers are written as zigzag varint
+			double Number = Value->AsNumber();
+			if (FMath::IsFinite(Number) && FMath::Abs(Number) < double(MAX_int64) && Number == FMath::FloorToDouble(Number))
+			{
+				WriteType(EValueType::Integer);
+				const int64 Integer = static_cast<int64>(Number);
+				WriteVarInt(Ar, (uint64(Integer) << 1) ^ uint64(Integer >> 63));
+			}
+			else
+			{
+				WriteType(EValueType::Double);
+				Ar << Number;
+			}
+			break;
+		}
+
+		case EJson::String:
+			WriteType(EValueType::String);
+			WriteVarInt(Ar, Strings.FindChecked(Value->AsString()));
+			break;
+
+		case EJson::Array:
+		{
+			WriteType(EValueType::Array);
+			const int64 LengthPos = BeginLengthPrefix(Ar);
+			const TArray<TSharedPtr<FJsonValue>>& Values = Value->AsArray();
+			WriteVarInt(Ar, Values.Num());
+			for (const TSharedPtr<FJsonValue>& Element : Values)
+				WriteValue(Ar, Strings, Element);
+			EndLengthPrefix(Ar, LengthPos);
+			break;
+		}
+
+		case EJson::Object:
+		{
+			WriteType(EValueType::Object);
+			const int64 LengthPos = BeginLengthPrefix(Ar);
+			const TSharedPtr<FJsonObject>& Object = Value->AsObject();
+			WriteVarInt(Ar, Object->Values.Num());
+			// The order of fields is kept (SubObjectRef must go first)
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Object->Values)
+			{
+				WriteVarInt(Ar, Strings.FindChecked(Field.Key));
+				WriteValue(Ar, Strings, Field.Value);
+			}
+			EndLengthPrefix(Ar, LengthPos);
+			break;
+		}
+
+		default:
+			WriteType(EValueType::Null);
+			break;
+		}
+	}
+
+	struct FReadContext
+	{
+		FArchive& Ar;
+		uint16 Version;
+		TArray<FString> Strings;
+	};
+
+	bool ReadStringTable(FReadContext& Context)
+	{
+		FArchive& Ar = Context.Ar;
+		const uint64 Count = ReadVarInt(Ar);
+		// Each string takes at least its length byte
+		if (Ar.IsError() || int64(Count) > Ar.TotalSize() - Ar.Tell())
+			return false;
+
+		Context.Strings.SetNum(static_cast<int32>(Count));
+		for (FString& String : Context.Strings)
+		{
+			if (!ReadString(Ar, String))
+				return false;
+		}
+		return true;
+	}
+
+	// String value or field name: index in the string table, inline string in the first version
+	bool ReadStringRef(FReadContext& Context, FString& OutValue)
+	{
+		if (Context.Version < FirstStringTableVersion)
+			return ReadString(Context.Ar, OutValue);
+
+		const uint64 Index = ReadVarInt(Context.Ar);
+		if (Context.Ar.IsError() || Index >= uint64(Context.Strings.Num()))
+			return false;
+		OutValue = Context.Strings[static_cast<int32>(Index)];
+		return true;
+	}
+
+	// Returns false if the data is corrupted. OutValue is nullptr if the value of unknown type was skipped
+	bool ReadValue(FReadContext& Context, int32 Depth, TSharedPtr<FJsonValue>& OutValue)
+	{
+		using namespace FJsonBinaryFormat;
+
+		FArchive& Ar = Context.Ar;
+		OutValue.Reset();
+
+		uint8 TypeByte = 0;
+		Ar << TypeByte;
+		if (Ar.IsError())
+			return false;
+
+		switch (static_cast<EValueType>(TypeByte))
+		{
+		case EValueType::Null:
+			OutValue = MakeShared<FJsonValueNull>();
+			return true;
+
+		case EValueType::False:
+		case EValueType::True:
+			OutValue = MakeShared<FJsonValueBoolean>(TypeByte == uint8(EValueType::True));
+			return true;
+
+		case EValueType::Integer:
+		{
+			const uint64 ZigZag = ReadVarInt(Ar);
+			const int64 Integer = int64(ZigZag >> 1) ^ -int64(ZigZag & 1);
+			OutValue = MakeShared<FJsonValueNumber>(double(Integer));
+			return !Ar.IsError();
+		}
+
+		case EValueType::Double:
+		{
+			double Number = 0.0;
+			Ar << Number;
+			OutValue = MakeShared<FJsonValueNumber>(Number);
+			return !Ar.IsError();
+		}
+
+		case EValueType::String:
+		{
+			FString String;
+			if (!ReadStringRef(Context, String))
+				return false;
+			OutValue = MakeShared<FJsonValueString>(String);
+			return true;
+		}
+
+		case EValueType::Array:
+		{
+			uint32 Length = 0;
+			Ar << Length;
+			const uint64 Count = ReadVarInt(Ar);
+			if (Ar.IsError() || Count > Length || Depth >= MaxDepth)
+				return false;
+
+			TArray<TSharedPtr<FJsonValue>> Values;
+			Values.Reserve(static_cast<int32>(Count));
+			for (uint64 Index = 0; Index < Count; ++Index)
+			{
+				TSharedPtr<FJsonValue> Element;
+				if (!ReadValue(Context, Depth + 1, Element))
+					return false;
+				// Values of unknown types are skipped, except array elements, where the position matters
+				Values.Add(Element.IsValid() ? Element : MakeShared<FJsonValueNull>());
+			}
+			OutValue = MakeShared<FJsonValueArray>(Values);
+			return true;
+		}
+
+		case EValueType::Object:
+		{
+			uint32 Length = 0;
+			Ar << Length;
+			const uint64 Count = ReadVarInt(Ar);
+			if (Ar.IsError() || Count > Length || Depth >= MaxDepth)
+				return false;
+
+			TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+			for (uint64 Index = 0; Index < Count; ++Index)
+			{
+				FString Key;
+				TSharedPtr<FJsonValue> FieldValue;
+				if (!ReadStringRef(Context, Key) || !ReadValue(Context, Depth + 1, FieldValue))
+					return false;
+				// Fields of unknown types are skipped
+				if (FieldValue.IsValid())
+					Object->SetField(Key, FieldValue);
+			}
+			OutValue = MakeShared<FJsonValueObject>(Object);
+			return true;
+		}
+
+		default:
+		{
+			if (TypeByte < uint8(EValueType::FirstSkippableType))
+				return false;
+
+			// Unknown type of newer version: skip the payload
+			const uint64 Length = ReadVarInt(Ar);
+			if (Ar.IsError() || int64(Length) > Ar.TotalSize() - Ar.Tell())
+				return false;
+			Ar.Seek(Ar.Tell() + Length);
+			return true;
+		}
+		}
+	}
+}
+
+namespace FJsonBinaryFormat
+{
+	bool SaveToFile(const TSharedPtr<FJsonValue>& Value, const FString& InSaveFilePath)
+	{
+		JSON_CONVERTER_TIMER_SCOPE(SaveFile);
+		TUniquePtr<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*InSaveFilePath));
+		if (!FileWriter)
+			return false;
+
+		uint32 Magic = FJsonBinaryFormatLocal::Magic;
+		uint16 Version = FJsonBinaryFormatLocal::Version;
+		*FileWriter << Magic;
+		*FileWriter << Version;
+
+		FJsonBinaryFormatLocal::FStringIndices Strings;
+		FJsonBinaryFormatLocal::CollectStrings(Value, Strings);
+		FJsonBinaryFormatLocal::WriteVarInt(*FileWriter, Strings.Num());
+		// Indices are given in the order of adding, so the table is written in the order of the map
+		for (const TPair<FString, int32>& String : Strings)
+			FJsonBinaryFormatLocal::WriteString(*FileWriter, String.Key);
+
+		FJsonBinaryFormatLocal::WriteValue(*FileWriter, Strings, Value);
+		return FileWriter->Close();
+	}
+
+	TSharedPtr<FJsonValue> LoadFromFile(const FString& InOpenFilePath)
+	{
+		TUniquePtr<FArchive> FileReader(IFileManager::Get().CreateFileReader(*InOpenFilePath));
+		if (!FileReader)
+			return nullptr;
+
+		uint32 Magic = 0;
+		uint16 Version = 0;
+		*FileReader << Magic;
+		*FileReader << Version;
+		if (FileReader->IsError() || Magic != FJsonBinaryFormatLocal::Magic || Version > FJsonBinaryFormatLocal::Version)
+			return nullptr;
+
+		FJsonBinaryFormatLocal::FReadContext Context{*FileReader, Version, {}};
+		if (Version >= FJsonBinaryFormatLocal::FirstStringTableVersion && !FJsonBinaryFormatLocal::ReadStringTable(Context))
+			return nullptr;
+
+		TSharedPtr<FJsonValue> Value;
+		if (!FJsonBinaryFormatLocal::ReadValue(Context, 0, Value))
+			return nullptr;
+		return Value;
+	}
+
+	bool IsBinaryFile(const FString& InFilePath)
+	{
+		TUniquePtr<FArchive> FileReader(IFileManager::Get().CreateFileReader(*InFilePath));
+		if (!FileReader || FileReader->TotalSize() < int64(sizeof(uint32)))
+			return false;
+
+		uint32 Magic = 0;
+		*FileReader << Magic;
+		return Magic == FJsonBinaryFormatLocal::Magic;
+	}
+
+	bool ConvertJsonToBinary(const FString& InJsonFilePath, const FString& InBinaryFilePath)
+	{
+		const TSharedPtr<FJsonValue> JsonValue = FCustomCallbacksDemoLocal::LoadJsonFile(InJsonFilePath);
+		return JsonValue.IsValid() && SaveToFile(JsonValue, InBinaryFilePath);
+	}
+
+	bool ConvertBinaryToJson(const FString& InBinaryFilePath, const FString& InJsonFilePath)
+	{
+		const TSharedPtr<FJsonValue> JsonValue = LoadFromFile(InBinaryFilePath);
+		if (!JsonValue.IsValid())
+			return false;
+
+		FString SerializedJson;
+		if (!FJsonSerializer::Serialize(JsonValue, FString(), TJsonWriterFactory<>::Create(&SerializedJson)))
+			return false;
+		return FFileHelper::SaveStringToFile(SerializedJson, *InJsonFilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+	}
+}
@@ -0,0 +1,57 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+
+/**
+ * Compact binary interchange format with the same semantics as the exported json
+ * (so instanced sub objects are carried by the "SubObjectRef" convention as well).
+ *
+ * File: "UCJB" magic, uint16 version, string table, then one value.
+ * String table: varint count, strings (varint byte length, UTF-8 bytes). Each field name and string value
+ * (e.g. repeated reference) is stored once.
+ * Value: uint8 type, followed by:
+ *   Null, False, True - nothing;
+ *   Integer - zigzag varint; Double - 8 bytes;
+ *   String - varint index in the string table;
+ *   Array - uint32 byte length of the rest, varint count, values;
+ *   Object - uint32 byte length of the rest, varint count, (key as varint index in the string table, value) pairs;
+ *   types >= FirstSkippableType - varint byte length, payload. Readers skip the types they don't know.
+ * Files of version 1 (strings and keys inline, without the table) are read as well.
+ * Nesting of arrays and objects deeper than 256 levels is treated as corrupted data.
+ *
+ * The file is read into the FJsonValue tree and imported by the same code as json, so the import saves only
+ * the text parsing, not the conversion to properties.
+ */
+namespace FJsonBinaryFormat
+{
+	enum class EValueType : uint8
+	{
+		Null,
+		False,
+		True,
+		Integer,
+		Double,
+		String,
+		Array,
+		Object,
+
+		FirstSkippableType = 16
+	};
+
+	static const FString FileExtension = TEXT(".jsonb");
+
+	bool SaveToFile(const TSharedPtr<FJsonValue>& Value, const FString& InSaveFilePath);
+	// nullptr if the file can't be read or the data is corrupted
+	TSharedPtr<FJsonValue> LoadFromFile(const FString& InOpenFilePath);
+
+	// Whether the file starts with the binary format magic
+	bool IsBinaryFile(const FString& InFilePath);
+
+	// Converters between json text and binary files
+	bool ConvertJsonToBinary(const FString& InJsonFilePath, const FString& InBinaryFilePath);
+	bool ConvertBinaryToJson(const FString& InBinaryFilePath, const FString& InJsonFilePath);
+}
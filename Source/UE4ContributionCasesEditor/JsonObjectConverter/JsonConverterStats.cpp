@@ -0,0 +1,74 @@
+#include "JsonConverterStats.h"
+
+#include "CustomImportCallbackCommandlet.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+
+namespace FJsonConverterStatsLocal
+{
+	static const TCHAR* CounterNames[] = { TEXT("ObjectsVisited"), TEXT("PropertiesConverted"), TEXT("SubObjectsCreated"), TEXT("BytesRead"), TEXT("BytesWritten") };
+	static const TCHAR* TimerNames[] = { TEXT("Export"), TEXT("Import"), TEXT("LoadFile"), TEXT("SaveFile"), TEXT("SavePackages") };
+
+	static_assert(UE_ARRAY_COUNT(CounterNames) == static_cast<int32>(EJsonConverterCounter::Num), "Name of each counter is required");
+	static_assert(UE_ARRAY_COUNT(TimerNames) == static_cast<int32>(EJsonConverterTimer::Num), "Name of each timer is required");
+}
+
+FJsonConverterStats& FJsonConverterStats::Get()
+{
+	static FJsonConverterStats Instance;
+	return Instance;
+}
+
+void FJsonConverterStats::Reset()
+{
+	for (int32 Index = 0; Index < static_cast<int32>(EJsonConverterCounter::Num); ++Index)
+		Counters[Index] = 0;
+	for (int32 Index = 0; Index < static_cast<int32>(EJsonConverterTimer::Num); ++Index)
+	{
+		TimerCycles[Index] = 0;
+		TimerCalls[Index] = 0;
+	}
+	StartSeconds = FPlatformTime::Seconds();
+}
+
+void FJsonConverterStats::PrintSummary() const
+{
+	using namespace FJsonConverterStatsLocal;
+
+	UE_LOG(LogDemoJsonCallback, Display, TEXT("--- Json converter stats (%.3f s) ---"), FPlatformTime::Seconds() - StartSeconds);
+	UE_LOG(LogDemoJsonCallback, Display, TEXT("%-24s %16s"), TEXT("Counter"), TEXT("Value"));
+	for (int32 Index = 0; Index < static_cast<int32>(EJsonConverterCounter::Num); ++Index)
+		UE_LOG(LogDemoJsonCallback, Display, TEXT("%-24s %16lld"), CounterNames[Index], Counters[Index]);
+
+	UE_LOG(LogDemoJsonCallback, Display, TEXT("%-24s %10s %12s %12s"), TEXT("Phase"), TEXT("Calls"), TEXT("Total ms"), TEXT("ms/call"));
+	for (int32 Index = 0; Index < static_cast<int32>(EJsonConverterTimer::Num); ++Index)
+	{
+		const double TotalMs = FPlatformTime::ToMilliseconds64(TimerCycles[Index]);
+		UE_LOG(LogDemoJsonCallback, Display, TEXT("%-24s %10lld %12.3f %12.3f"), TimerNames[Index], TimerCalls[Index], TotalMs, TimerCalls[Index] > 0 ? TotalMs / TimerCalls[Index] : 0.0);
+	}
+}
+
+bool FJsonConverterStats::AppendCsv(const FString& InFilePath, const FString& InMode) const
+{
+	using namespace FJsonConverterStatsLocal;
+
+	FString Csv;
+	if (!FPaths::FileExists(InFilePath))
+	{
+		Csv += TEXT("Timestamp,EngineVersion,Mode,TotalMs");
+		for (const TCHAR* CounterName : CounterNames)
+			Csv += FString::Printf(TEXT(",%s"), CounterName);
+		for (const TCHAR* TimerName : TimerNames)
+			Csv += FString::Printf(TEXT(",%sCalls,%sMs"), TimerName, TimerName);
+		Csv += TEXT("\n");
+	}
+
+	Csv += FString::Printf(TEXT("%s,%s,%s,%.3f"), *FDateTime::UtcNow().ToIso8601(), *FEngineVersion::Current().ToString(), *InMode, (FPlatformTime::Seconds() - StartSeconds) * 1000.0);
+	for (int32 Index = 0; Index < static_cast<int32>(EJsonConverterCounter::Num); ++Index)
+		Csv += FString::Printf(TEXT(",%lld"), Counters[Index]);
+	for (int32 Index = 0; Index < static_cast<int32>(EJsonConverterTimer::Num); ++Index)
+		Csv += FString::Printf(TEXT(",%lld,%.3f"), TimerCalls[Index], FPlatformTime::ToMilliseconds64(TimerCycles[Index]));
+	Csv += TEXT("\n");
+
+	return FFileHelper::SaveStringToFile(Csv, *InFilePath, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append);
+}
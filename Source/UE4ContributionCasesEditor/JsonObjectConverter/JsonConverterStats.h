@@ -0,0 +1,79 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+// Counters of the json export/import paths
+enum class EJsonConverterCounter : uint8
+{
+	ObjectsVisited,
+	PropertiesConverted,
+	SubObjectsCreated,
+	BytesRead,
+	BytesWritten,
+	Num
+};
+
+// Timed phases (time is summed over all threads, so parallel phases report thread time)
+enum class EJsonConverterTimer : uint8
+{
+	Export,
+	Import,
+	LoadFile,
+	SaveFile,
+	SavePackages,
+	Num
+};
+
+/**
+ * Per-run statistics of UCustomImportCallbackCommandlet: counters and phase times are collected from any thread
+ * and reported at the end of the run as a summary table and a CSV row.
+ */
+class FJsonConverterStats
+{
+public:
+	static FJsonConverterStats& Get();
+
+	void Add(EJsonConverterCounter Counter, int64 Value = 1)
+	{
+		FPlatformAtomics::InterlockedAdd(&Counters[static_cast<int32>(Counter)], Value);
+	}
+
+	void AddTime(EJsonConverterTimer Timer, uint64 Cycles)
+	{
+		FPlatformAtomics::InterlockedAdd(&TimerCycles[static_cast<int32>(Timer)], static_cast<int64>(Cycles));
+		FPlatformAtomics::InterlockedIncrement(&TimerCalls[static_cast<int32>(Timer)]);
+	}
+
+	void Reset();
+
+	void PrintSummary() const;
+	// Append one row per run ("%ProjectSavedDir%/JsonConverterStats.csv" by default)
+	bool AppendCsv(const FString& InFilePath, const FString& InMode) const;
+
+	struct FScopedTimer
+	{
+		explicit FScopedTimer(EJsonConverterTimer InTimer) : Timer(InTimer), StartCycles(FPlatformTime::Cycles64()) {}
+		~FScopedTimer() { FJsonConverterStats::Get().AddTime(Timer, FPlatformTime::Cycles64() - StartCycles); }
+
+		EJsonConverterTimer Timer;
+		uint64 StartCycles;
+	};
+
+private:
+	FJsonConverterStats() { Reset(); }
+
+	volatile int64 Counters[static_cast<int32>(EJsonConverterCounter::Num)];
+	volatile int64 TimerCycles[static_cast<int32>(EJsonConverterTimer::Num)];
+	volatile int64 TimerCalls[static_cast<int32>(EJsonConverterTimer::Num)];
+	double StartSeconds = 0.0;
+};
+
+// Trace scope (Unreal Insights) and per-run time of the phase
+#define JSON_CONVERTER_TIMER_SCOPE(Timer) \
+	TRACE_CPUPROFILER_EVENT_SCOPE(JsonConverter_##Timer); \
+	FJsonConverterStats::FScopedTimer JsonConverterTimer_##Timer(EJsonConverterTimer::Timer)
+
+#define JSON_CONVERTER_COUNT(Counter, Value) FJsonConverterStats::Get().Add(EJsonConverterCounter::Counter, Value)
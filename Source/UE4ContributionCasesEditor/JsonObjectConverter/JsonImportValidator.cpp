@@ -0,0 +1,422 @@
+#include "JsonImportValidator.h"
+
+#include "ClassNameIndex.h"
+#include "CustomJsonCallbacks.h"
+#include "JsonArenaDocument.h"
+#include "JsonObjectGraph.h"
+#include "PropertySchemaCache.h"
+#include "Misc/PackageName.h"
+#include "UE4ContributionCasesEditor/SplitFullObjectPathCase/ObjectPathSplitter.h"
+
+namespace FJsonImportValidatorLocal
+{
+	const TCHAR* GetJsonTypeName(EJson Type)
+	{
+		switch (Type)
+		{
+		case EJson::None: return TEXT("none");
+		case EJson::Null: return TEXT("null");
+		case EJson::String: return TEXT("string");
+		case EJson::Number: return TEXT("number");
+		case EJson::Boolean: return TEXT("boolean");
+		case EJson::Array: return TEXT("array");
+		case EJson::Object: return TEXT("object");
+		default: return TEXT("unknown");
+		}
+	}
+
+	void AddTypeProblem(const FString& Path, const TCHAR* Expected, EJson Found, TArray<FString>& OutProblems)
+	{
+		OutProblems.Add(FString::Printf(TEXT("%s: %s expected, but %s found"), *Path, Expected, GetJsonTypeName(Found)));
+	}
+
+	bool IsScalar(EJson Type)
+	{
+		return Type == EJson::String || Type == EJson::Number || Type == EJson::Boolean;
+	}
+
+	FString ToString(FStringView InView)
+	{
+		return FString(InView.Len(), InView.GetData());
+	}
+
+	// Path segment is appended for the lifetime of the scope, the buffer of the path is reused
+	struct FScopedPathField
+	{
+		FScopedPathField(FString& InPath, const FString& InFieldName) : Path(InPath), PathLen(InPath.Len())
+		{
+			Path += TEXT(".");
+			Path += InFieldName;
+		}
+		FScopedPathField(FString& InPath, int32 InIndex) : Path(InPath), PathLen(InPath.Len())
+		{
+			Path += TEXT("[");
+			Path.AppendInt(InIndex);
+			Path += TEXT("]");
+		}
+		~FScopedPathField() { Path.LeftInline(PathLen, false); }
+
+		FString& Path;
+		int32 PathLen;
+	};
+}
+
+void FJsonImportValidator::ValidateRecord(const FJsonArenaDocument& Document, TArray<FString>& OutProblems)
+{
+	using namespace FCustomCallbacksDemoLocal;
+	using namespace FJsonImportValidatorLocal;
+
+	const int32 RootIndex = FJsonArenaDocument::RootIndex;
+	if (Document.IsEmpty() || Document.GetNode(RootIndex).Type != EJson::Object)
+	{
+		OutProblems.Add(TEXT("unexpected content"));
+		return;
+	}
+
+	const int32 AssetRefIndex = Document.FindField(RootIndex, AssetRefPropertyName);
+	if (AssetRefIndex == INDEX_NONE || Document.GetNode(AssetRefIndex).Type != EJson::String)
+	{
+		OutProblems.Add(FString::Printf(TEXT("field '%s' not found"), *AssetRefPropertyName));
+		return;
+	}
+
+	const FStringView AssetRef = Document.GetString(AssetRefIndex);
+	const FObjectPathView PathView = FObjectPathSplitter::Split(AssetRef);
+	if (PathView.ClassName.IsEmpty() || PathView.PackageName.IsEmpty() || PathView.ObjectName.IsEmpty() || !PathView.SubObjectName.IsEmpty())
+	{
+		OutProblems.Add(FString::Printf(TEXT("invalid asset reference '%s'"), *ToString(AssetRef)));
+		return;
+	}
+
+	const UClass* Class = FClassNameIndex::Get().FindClass(ToString(PathView.ClassName));
+	if (!Class)
+	{
+		OutProblems.Add(FString::Printf(TEXT("class of '%s' not found"), *ToString(AssetRef)));
+		return;
+	}
+
+	const FString PackageName = ToString(PathView.PackageName);
+	if (!DoesPackageExist(PackageName))
+		OutProblems.Add(FString::Printf(TEXT("package '%s' does not exist"), *PackageName));
+
+	FString Path = ToString(PathView.ObjectName);
+	ValidateObjectFields(Class, Document, RootIndex, Path, OutProblems);
+}
+
+void FJsonImportValidator::ValidateObjectFields(const UClass* Class, const FJsonArenaDocument& Document, int32 ObjectIndex, FString& Path, TArray<FString>& OutProblems)
+{
+	using namespace FCustomCallbacksDemoLocal;
+	using namespace FJsonImportValidatorLocal;
+
+	const FPropertySchema& Schema = FPropertySchemaCache::Get().GetSchema(Class);
+	for (const int32 FieldIndex : Document.GetChildren(ObjectIndex))
+	{
+		const FString& FieldName = Document.GetKey(FieldIndex);
+		if (IsRecordMetadataField(FieldName) || FieldName == CustomAdditionalPropertyName)
+			continue;
+
+		FScopedPathField PathField(Path, FieldName);
+		if (FieldName == FJsonObjectGraph::ObjectsFieldName)
+		{
+			ValidateObjectTable(Document, FieldIndex, Path, OutProblems);
+			continue;
+		}
+
+		const FCachedProperty* CachedProperty = Schema.FindProperty(FieldName);
+		if (!CachedProperty)
+		{
+			OutProblems.Add(FString::Printf(TEXT("%s: property not found in class %s"), *Path, *Class->GetName()));
+			continue;
+		}
+		ValidateValue(CachedProperty->Property, Document, FieldIndex, Path, OutProblems);
+	}
+}
+
+void FJsonImportValidator::ValidateStructFields(const UStruct* Struct, const FJsonArenaDocument& Document, int32 ObjectIndex, FString& Path, TArray<FString>& OutProblems)
+{
+	using namespace FJsonImportValidatorLocal;
+
+	// Struct fields are named by StandardizeCase, FName lookup is case-insensitive
+	const FPropertySchema& Schema = FPropertySchemaCache::Get().GetSchema(Struct);
+	for (const int32 FieldIndex : Document.GetChildren(ObjectIndex))
+	{
+		const FString& FieldName = Document.GetKey(FieldIndex);
+		FScopedPathField PathField(Path, FieldName);
+
+		const FCachedProperty* CachedProperty = Schema.FindProperty(FieldName);
+		if (!CachedProperty)
+		{
+			OutProblems.Add(FString::Printf(TEXT("%s: property not found in struct %s"), *Path, *Struct->GetName()));
+			continue;
+		}
+		ValidateValue(CachedProperty->Property, Document, FieldIndex, Path, OutProblems);
+	}
+}
+
+void FJsonImportValidator::ValidateValue(const FProperty* Property, const FJsonArenaDocument& Document, int32 NodeIndex, FString& Path, TArray<FString>& OutProblems)
+{
+	using namespace FJsonImportValidatorLocal;
+
+	if (Property->ArrayDim == 1)
+	{
+		ValidateScalarValue(Property, Document, NodeIndex, Path, OutProblems);
+		return;
+	}
+
+	// Static array
+	const FJsonArenaNode& Node = Document.GetNode(NodeIndex);
+	if (Node.Type != EJson::Array)
+	{
+		AddTypeProblem(Path, TEXT("array"), Node.Type, OutProblems);
+		return;
+	}
+	if (Node.Num > Property->ArrayDim)
+		OutProblems.Add(FString::Printf(TEXT("%s: %d elements, but the static array has %d"), *Path, Node.Num, Property->ArrayDim));
+
+	const TArrayView<const int32> Elements = Document.GetChildren(NodeIndex);
+	for (int32 Index = 0; Index < Elements.Num(); ++Index)
+	{
+		FScopedPathField PathField(Path, Index);
+		ValidateScalarValue(Property, Document, Elements[Index], Path, OutProblems);
+	}
+}
+
+void FJsonImportValidator::ValidateScalarValue(const FProperty* Property, const FJsonArenaDocument& Document, int32 NodeIndex, FString& Path, TArray<FString>& OutProblems)
+{
+	using namespace FJsonImportValidatorLocal;
+
+	if (const FObjectPropertyBase* ObjectProperty = CastField<FObjectPropertyBase>(Property))
+	{
+		ValidateObjectValue(ObjectProperty, Document, NodeIndex, Path, OutProblems);
+		return;
+	}
+
+	const FJsonArenaNode& Node = Document.GetNode(NodeIndex);
+
+	// Enum values are written as names
+	const UEnum* Enum = nullptr;
+	if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+		Enum = EnumProperty->GetEnum();
+	else if (const FByteProperty* ByteProperty = CastField<FByteProperty>(Property))
+		Enum = ByteProperty->Enum;
+	if (Enum)
+	{
+		if (Node.Type == EJson::String)
+		{
+			const FString EnumName = ToString(Document.GetString(NodeIndex));
+			if (Enum->GetValueByNameString(EnumName) == INDEX_NONE)
+				OutProblems.Add(FString::Printf(TEXT("%s: '%s' is not a value of enum %s"), *Path, *EnumName, *Enum->GetName()));
+		}
+		else if (Node.Type != EJson::Number)
+		{
+			AddTypeProblem(Path, TEXT("enum name"), Node.Type, OutProblems);
+		}
+		return;
+	}
+
+	if (CastField<FNumericProperty>(Property))
+	{
+		// Numbers are accepted from strings as well
+		if (Node.Type == EJson::String)
+		{
+			const FString NumberString = ToString(Document.GetString(NodeIndex));
+			if (!NumberString.IsNumeric())
+				OutProblems.Add(FString::Printf(TEXT("%s: '%s' is not a number"), *Path, *NumberString));
+		}
+		else if (Node.Type != EJson::Number)
+		{
+			AddTypeProblem(Path, TEXT("number"), Node.Type, OutProblems);
+		}
+		return;
+	}
+
+	if (CastField<FBoolProperty>(Property) || CastField<FStrProperty>(Property) || CastField<FNameProperty>(Property) || CastField<FTextProperty>(Property))
+	{
+		if (!IsScalar(Node.Type))
+			AddTypeProblem(Path, TEXT("scalar"), Node.Type, OutProblems);
+		return;
+	}
+
+	const FProperty* ElementProperty = nullptr;
+	if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+		ElementProperty = ArrayProperty->Inner;
+	else if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+		ElementProperty = SetProperty->ElementProp;
+	if (ElementProperty)
+	{
+		if (Node.Type != EJson::Array)
+		{
+			AddTypeProblem(Path, TEXT("array"), Node.Type, OutProblems);
+			return;
+		}
+		const TArrayView<const int32> Elements = Document.GetChildren(NodeIndex);
+		for (int32 Index = 0; Index < Elements.Num(); ++Index)
+		{
+			FScopedPathField PathField(Path, Index);
+			ValidateValue(ElementProperty, Document, Elements[Index], Path, OutProblems);
+		}
+		return;
+	}
+
+	if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+	{
+		if (Node.Type != EJson::Object)
+		{
+			AddTypeProblem(Path, TEXT("object"), Node.Type, OutProblems);
+			return;
+		}
+		for (const int32 PairIndex : Document.GetChildren(NodeIndex))
+		{
+			FScopedPathField PathField(Path, Document.GetKey(PairIndex));
+			ValidateValue(MapProperty->ValueProp, Document, PairIndex, Path, OutProblems);
+		}
+		return;
+	}
+
+	if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+	{
+		// Structs with ExportTextItem are written as strings
+		if (Node.Type == EJson::Object)
+			ValidateStructFields(StructProperty->Struct, Document, NodeIndex, Path, OutProblems);
+		else if (Node.Type != EJson::String)
+			AddTypeProblem(Path, TEXT("object"), Node.Type, OutProblems);
+		return;
+	}
+
+	// Other properties are imported from text
+	if (!IsScalar(Node.Type) && Node.Type != EJson::Null)
+		AddTypeProblem(Path, TEXT("scalar"), Node.Type, OutProblems);
+}
+
+void FJsonImportValidator::ValidateObjectValue(const FObjectPropertyBase* Property, const FJsonArenaDocument& Document, int32 NodeIndex, FString& Path, TArray<FString>& OutProblems)
+{
+	using namespace FJsonImportValidatorLocal;
+
+	const FJsonArenaNode& Node = Document.GetNode(NodeIndex);
+	if (Node.Type == EJson::Null)
+		return;
+
+	if (Node.Type == EJson::String)
+	{
+		const FStringView Reference = Document.GetString(NodeIndex);
+		if (!Reference.IsEmpty() && Reference != TEXT("None"))
+			ValidateReference(Reference, false, Path, OutProblems);
+		return;
+	}
+
+	// Instanced (sub) object
+	if (Node.Type != EJson::Object)
+	{
+		AddTypeProblem(Path, TEXT("object reference"), Node.Type, OutProblems);
+		return;
+	}
+
+	// Id of the object in the table of the graph-aware export
+	const int32 ObjectIdIndex = Document.FindField(NodeIndex, FJsonObjectGraph::ObjectIdFieldName);
+	if (ObjectIdIndex != INDEX_NONE)
+	{
+		if (Node.Num != 1 || Document.GetNode(ObjectIdIndex).Type != EJson::Number)
+			OutProblems.Add(FString::Printf(TEXT("%s: invalid '%s' reference"), *Path, *FJsonObjectGraph::ObjectIdFieldName));
+		return;
+	}
+
+	ValidateInstancedObject(Property->PropertyClass, Document, NodeIndex, Path, OutProblems);
+}
+
+void FJsonImportValidator::ValidateInstancedObject(const UClass* BaseClass, const FJsonArenaDocument& Document, int32 ObjectIndex, FString& Path, TArray<FString>& OutProblems)
+{
+	using namespace FCustomCallbacksDemoLocal;
+	using namespace FJsonImportValidatorLocal;
+
+	const int32 SubObjectRefIndex = Document.FindField(ObjectIndex, CustomAdditionalPropertyName);
+	if (SubObjectRefIndex == INDEX_NONE || Document.GetNode(SubObjectRefIndex).Type != EJson::String)
+	{
+		OutProblems.Add(FString::Printf(TEXT("%s: instanced object without '%s'"), *Path, *CustomAdditionalPropertyName));
+		return;
+	}
+
+	const FStringView SubObjectRef = Document.GetString(SubObjectRefIndex);
+	const FObjectPathView PathView = FObjectPathSplitter::Split(SubObjectRef);
+	{
+		FScopedPathField PathField(Path, CustomAdditionalPropertyName);
+		if (PathView.SubObjectName.IsEmpty())
+		{
+			OutProblems.Add(FString::Printf(TEXT("%s: '%s' is not a reference on instanced object"), *Path, *ToString(SubObjectRef)));
+			return;
+		}
+		ValidateReference(SubObjectRef, true, Path, OutProblems);
+	}
+
+	UClass* SubObjectClass = FClassNameIndex::Get().FindClass(ToString(PathView.ClassName));
+	if (!SubObjectClass)
+		return;
+	if (!SubObjectClass->IsChildOf(BaseClass))
+	{
+		OutProblems.Add(FString::Printf(TEXT("%s: class %s is not %s"), *Path, *SubObjectClass->GetName(), *BaseClass->GetName()));
+		return;
+	}
+	ValidateObjectFields(SubObjectClass, Document, ObjectIndex, Path, OutProblems);
+}
+
+void FJsonImportValidator::ValidateObjectTable(const FJsonArenaDocument& Document, int32 NodeIndex, FString& Path, TArray<FString>& OutProblems)
+{
+	using namespace FJsonImportValidatorLocal;
+
+	const FJsonArenaNode& Node = Document.GetNode(NodeIndex);
+	if (Node.Type != EJson::Object)
+	{
+		AddTypeProblem(Path, TEXT("object"), Node.Type, OutProblems);
+		return;
+	}
+
+	for (const int32 EntryIndex : Document.GetChildren(NodeIndex))
+	{
+		const FString& ObjectId = Document.GetKey(EntryIndex);
+		FScopedPathField PathField(Path, ObjectId);
+		const EJson EntryType = Document.GetNode(EntryIndex).Type;
+		if (!ObjectId.IsNumeric())
+			OutProblems.Add(FString::Printf(TEXT("%s: object id is not a number"), *Path));
+		else if (EntryType != EJson::Object)
+			AddTypeProblem(Path, TEXT("object"), EntryType, OutProblems);
+		else
+			ValidateInstancedObject(UObject::StaticClass(), Document, EntryIndex, Path, OutProblems);
+	}
+}
+
+void FJsonImportValidator::ValidateReference(FStringView InReference, bool bRequireClass, const FString& Path, TArray<FString>& OutProblems)
+{
+	using namespace FJsonImportValidatorLocal;
+
+	// "Class'/Package/Path.Object:SubObject'"
+	const FObjectPathView PathView = FObjectPathSplitter::Split(InReference);
+	if (PathView.ClassName.IsEmpty() || PathView.PackageName.IsEmpty() || PathView.ObjectName.IsEmpty())
+	{
+		OutProblems.Add(FString::Printf(TEXT("%s: invalid object reference '%s'"), *Path, *ToString(InReference)));
+		return;
+	}
+
+	// Native objects ("/Script/...") are not in packages on disk, their classes are always loaded
+	const FString PackageName = ToString(PathView.PackageName);
+	const bool bNativePackage = PackageName.StartsWith(TEXT("/Script/"));
+	if (!bNativePackage && !DoesPackageExist(PackageName))
+		OutProblems.Add(FString::Printf(TEXT("%s: package '%s' does not exist"), *Path, *PackageName));
+
+	const FString ClassName = ToString(PathView.ClassName);
+	if ((bRequireClass || bNativePackage) && !FClassNameIndex::Get().FindClass(ClassName))
+		OutProblems.Add(FString::Printf(TEXT("%s: class '%s' not found"), *Path, *ClassName));
+}
+
+bool FJsonImportValidator::DoesPackageExist(const FString& InPackageName)
+{
+	{
+		FReadScopeLock ReadLock(PackagesLock);
+		if (const bool* bExists = PackageExists.Find(InPackageName))
+			return *bExists;
+	}
+
+	const bool bExists = FPackageName::DoesPackageExist(InPackageName);
+
+	FWriteScopeLock WriteLock(PackagesLock);
+	PackageExists.Add(InPackageName, bExists);
+	return bExists;
+}
@@ -0,0 +1,42 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonArenaDocument;
+
+/**
+ * Dry-run check of the json records against the class schemas, without loading objects ("-Validate").
+ * Checks property names and json types of the values (recursive for containers, structs and instanced objects),
+ * syntax of "AssetRef", "SubObjectRef" and object references, and existence of the referenced packages.
+ * The class must be loaded only for "AssetRef" and "SubObjectRef" (their fields are checked against it): a plain reference
+ * may be of a blueprint class which is not loaded without loading the asset.
+ * All problems of the record are reported, not only the first one. Thread-safe.
+ * Records are read from FJsonArenaDocument, so a worker checking a stream of records does not allocate json values.
+ */
+class FJsonImportValidator
+{
+public:
+	// Problems of the asset record (root object of the document)
+	void ValidateRecord(const FJsonArenaDocument& Document, TArray<FString>& OutProblems);
+
+	// Whether the package exists on disk (cached)
+	bool DoesPackageExist(const FString& InPackageName);
+
+private:
+	// Path is the text of the problem prefix, it is extended and restored while the values are walked
+	void ValidateObjectFields(const UClass* Class, const FJsonArenaDocument& Document, int32 ObjectIndex, FString& Path, TArray<FString>& OutProblems);
+	void ValidateStructFields(const UStruct* Struct, const FJsonArenaDocument& Document, int32 ObjectIndex, FString& Path, TArray<FString>& OutProblems);
+	void ValidateValue(const FProperty* Property, const FJsonArenaDocument& Document, int32 NodeIndex, FString& Path, TArray<FString>& OutProblems);
+	void ValidateScalarValue(const FProperty* Property, const FJsonArenaDocument& Document, int32 NodeIndex, FString& Path, TArray<FString>& OutProblems);
+	void ValidateObjectValue(const FObjectPropertyBase* Property, const FJsonArenaDocument& Document, int32 NodeIndex, FString& Path, TArray<FString>& OutProblems);
+	void ValidateInstancedObject(const UClass* BaseClass, const FJsonArenaDocument& Document, int32 ObjectIndex, FString& Path, TArray<FString>& OutProblems);
+	// "$Objects" of the graph-aware export (FJsonObjectGraph)
+	void ValidateObjectTable(const FJsonArenaDocument& Document, int32 NodeIndex, FString& Path, TArray<FString>& OutProblems);
+	// bRequireClass - the class of the reference must be resolved (the package is checked anyway)
+	void ValidateReference(FStringView InReference, bool bRequireClass, const FString& Path, TArray<FString>& OutProblems);
+
+	FRWLock PackagesLock;
+	TMap<FString, bool> PackageExists;
+};
@@ -0,0 +1,421 @@
+#include "JsonLinkerExport.h"
+
+#include "CustomImportCallbackCommandlet.h"
+#include "CustomJsonCallbacks.h"
+#include "JsonConverterStats.h"
+#include "PropertySchemaCache.h"
+#include "Misc/PackageName.h"
+#include "Serialization/ArchiveProxy.h"
+#include "Serialization/StructuredArchive.h"
+#include "UObject/LinkerLoad.h"
+#include "UObject/Package.h"
+#include "UObject/PropertyTag.h"
+#include "UObject/StructOnScope.h"
+#include "UObject/UObjectThreadContext.h"
+
+namespace FJsonLinkerExportLocal
+{
+	using namespace FCustomCallbacksDemoLocal;
+
+	// Reader of the export data: names are resolved by the name map of the linker, object references are never resolved
+	// (FLinkerLoad would load the referenced object)
+	class FLinkerPropertyReader : public FArchiveProxy
+	{
+	public:
+		explicit FLinkerPropertyReader(FLinkerLoad& InLinker) : FArchiveProxy(InLinker) {}
+
+		virtual FArchive& operator<<(UObject*& Value) override
+		{
+			FPackageIndex Index;
+			InnerArchive << Index;
+			Value = nullptr;
+			bObjectReferenceSkipped = true;
+			return *this;
+		}
+
+		virtual FArchive& operator<<(FWeakObjectPtr& Value) override
+		{
+			UObject* Object = nullptr;
+			*this << Object;
+			Value = nullptr;
+			return *this;
+		}
+
+		// A property serializer has read an object reference, so its value is not complete without loading
+		bool bObjectReferenceSkipped = false;
+	};
+
+	// Properties of the object which are taken from the loaded object
+	struct FPendingLoad
+	{
+		FString ObjectPath;
+		TSharedPtr<FJsonObject> JsonObject;
+		TArray<const FCachedProperty*> Properties;
+	};
+
+	struct FExportContext
+	{
+		explicit FExportContext(FLinkerLoad& InLinker) : Linker(InLinker), Reader(InLinker) {}
+
+		FLinkerLoad& Linker;
+		FLinkerPropertyReader Reader;
+		TArray<FPendingLoad> PendingLoads;
+		// Exports being read (a cycle of instanced references is taken from the loaded object)
+		TSet<int32> ExportsInProgress;
+	};
+
+	bool IsValidIndex(const FLinkerLoad& Linker, FPackageIndex Index)
+	{
+		return Index.IsImport() ? Linker.ImportMap.IsValidIndex(Index.ToImport()) : Linker.ExportMap.IsValidIndex(Index.ToExport());
+	}
+
+	// Path of the import/export as UObject::GetPathName gives it: "/Package.Object:SubObject.Nested"
+	FString GetObjectPath(FLinkerLoad& Linker, FPackageIndex Index)
+	{
+		TArray<FName, TInlineAllocator<4>> Names;
+		bool bOutermostIsExport = false;
+		for (; !Index.IsNull(); Index = Linker.ImpExp(Index).OuterIndex)
+		{
+			Names.Add(Linker.ImpExp(Index).ObjectName);
+			bOutermostIsExport = Index.IsExport();
+		}
+		// Outermost export is inside the package of the linker, outermost import is the package itself
+		if (bOutermostIsExport)
+			Names.Add(Linker.LinkerRoot->GetFName());
+
+		FString Path = Names.Last().ToString();
+		for (int32 NameIndex = Names.Num() - 2; NameIndex >= 0; --NameIndex)
+		{
+			Path += NameIndex == Names.Num() - 3 ? SUBOBJECT_DELIMITER : TEXT(".");
+			Path += Names[NameIndex].ToString();
+		}
+		return Path;
+	}
+
+	FName GetClassName(FLinkerLoad& Linker, FPackageIndex Index)
+	{
+		if (Index.IsImport())
+			return Linker.Imp(Index).ClassName;
+		const FPackageIndex ClassIndex = Linker.Exp(Index).ClassIndex;
+		return ClassIndex.IsNull() ? NAME_Class : Linker.ImpExp(ClassIndex).ObjectName;
+	}
+
+	// Whether the outer of the object is not a package (as in ObjectToJsonValue)
+	bool IsSubObject(FLinkerLoad& Linker, FPackageIndex Index)
+	{
+		const FPackageIndex OuterIndex = Linker.ImpExp(Index).OuterIndex;
+		if (Index.IsExport())
+			return !OuterIndex.IsNull();
+		return !OuterIndex.IsNull() && !Linker.ImpExp(OuterIndex).OuterIndex.IsNull();
+	}
+
+	// Whether the value of the tag is written by this property (otherwise the loader converts it, or skips it)
+	bool IsTagOfProperty(const FPropertyTag& Tag, const FProperty* Property)
+	{
+		const bool bSameType = Tag.Type == Property->GetID()
+			|| (CastField<FObjectProperty>(Property) && Tag.Type == NAME_ObjectProperty)
+			|| (CastField<FSoftObjectProperty>(Property) && Tag.Type == NAME_SoftObjectProperty);
+		if (!bSameType)
+			return false;
+
+		if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+			return Tag.StructName == StructProperty->Struct->GetFName();
+		if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+			return Tag.InnerType == ArrayProperty->Inner->GetID()
+				|| (CastField<FObjectProperty>(ArrayProperty->Inner) && Tag.InnerType == NAME_ObjectProperty)
+				|| (CastField<FSoftObjectProperty>(ArrayProperty->Inner) && Tag.InnerType == NAME_SoftObjectProperty);
+		if (const FByteProperty* ByteProperty = CastField<FByteProperty>(Property))
+			return (Tag.EnumName != NAME_None) == (ByteProperty->Enum != nullptr);
+		return true;
+	}
+
+	bool ReadTaggedProperties(FExportContext& Context, const UStruct* Struct, const void* Defaults, bool bObjectFields, int64 EndOffset, FJsonObject& OutJsonObject, TArray<const FCachedProperty*>* OutPropertiesToLoad);
+	bool ReadObjectProperties(FExportContext& Context, int32 ExportIndex, const TSharedRef<FJsonObject>& OutJsonObject);
+
+	// Json of the object reference: string reference, or the json object of the instanced sub object of this package.
+	// nullptr if the referenced object must be loaded
+	TSharedPtr<FJsonValue> ReadObjectReference(FExportContext& Context, FPackageIndex Index)
+	{
+		if (Index.IsNull())
+			return MakeShared<FJsonValueString>(TEXT("None"));
+		if (!IsValidIndex(Context.Linker, Index))
+			return nullptr;
+
+		const FString Reference = FString::Printf(TEXT("%s'%s'"), *GetClassName(Context.Linker, Index).ToString(), *GetObjectPath(Context.Linker, Index));
+		if (!IsSubObject(Context.Linker, Index))
+			return MakeShared<FJsonValueString>(Reference);
+		// Properties of the sub object of the other package are only in the loaded object
+		if (Index.IsImport())
+			return nullptr;
+
+		TSharedRef<FJsonObject> JsonInstancedObject = MakeShared<FJsonObject>();
+		JsonInstancedObject->SetStringField(CustomAdditionalPropertyName, Reference);
+		// The sub object is read from its own export, then the reading of the outer value continues
+		const int64 Position = Context.Reader.Tell();
+		const bool bRead = ReadObjectProperties(Context, Index.ToExport(), JsonInstancedObject);
+		Context.Reader.Seek(Position);
+		return bRead ? MakeShared<FJsonValueObject>(JsonInstancedObject) : nullptr;
+	}
+
+	// Json of the value at the current position, nullptr if the value can't be read without the object instances.
+	// Defaults is the value the tagged struct was saved against (the value in the archetype), nullptr for array elements
+	TSharedPtr<FJsonValue> ReadValue(FExportContext& Context, FProperty* Property, const void* Defaults, const FJsonObjectConverter::CustomExportCallback* ExportCallback, int64 EndOffset)
+	{
+		FArchive& Ar = Context.Reader;
+
+		// Object pointer is saved as the index in the import/export map
+		if (CastField<FObjectProperty>(Property))
+		{
+			FPackageIndex Index;
+			Ar << Index;
+			return ReadObjectReference(Context, Index);
+		}
+
+		if (FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+		{
+			int32 Num = 0;
+			Ar << Num;
+			// Array of structs has the tag of the inner property
+			if (CastField<FStructProperty>(ArrayProperty->Inner) && Ar.UE4Ver() >= VER_UE4_INNER_ARRAY_TAG_INFO)
+			{
+				FPropertyTag InnerTag;
+				Ar << InnerTag;
+				if (!IsTagOfProperty(InnerTag, ArrayProperty->Inner))
+					return nullptr;
+			}
+			if (Num < 0 || Num > EndOffset - Ar.Tell() || Ar.IsError())
+				return nullptr;
+
+			TArray<TSharedPtr<FJsonValue>> JsonElements;
+			JsonElements.Reserve(Num);
+			for (int32 Index = 0; Index < Num; ++Index)
+			{
+				TSharedPtr<FJsonValue> JsonElement = ReadValue(Context, ArrayProperty->Inner, nullptr, ExportCallback, EndOffset);
+				if (!JsonElement)
+					return nullptr;
+				JsonElements.Add(MoveTemp(JsonElement));
+			}
+			return MakeShared<FJsonValueArray>(JsonElements);
+		}
+
+		// Struct with tagged properties: the fields missing in the data have the values of Defaults, array elements
+		// have no defaults and are saved against the default values of the struct
+		FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+		if (StructProperty && !StructProperty->Struct->UseNativeSerialization() && !StructProperty->Struct->UseBinarySerialization(Ar))
+		{
+			TUniquePtr<FStructOnScope> StructDefaults;
+			if (Defaults == nullptr)
+			{
+				StructDefaults = MakeUnique<FStructOnScope>(StructProperty->Struct);
+				Defaults = StructDefaults->GetStructMemory();
+			}
+			const TSharedPtr<FJsonValue> JsonValue = FJsonObjectConverter::UPropertyToJsonValue(Property, Defaults, 0, 0, ExportCallback);
+			const TSharedPtr<FJsonObject> JsonObject = JsonValue.IsValid() ? JsonValue->AsObject() : nullptr;
+			if (!JsonObject || !ReadTaggedProperties(Context, StructProperty->Struct, Defaults, false, EndOffset, *JsonObject, nullptr))
+				return nullptr;
+			return JsonValue;
+		}
+
+		// Other values are deserialized by the property into a temporary value and converted as usual
+		void* Value = FMemory::Malloc(Property->ElementSize, Property->GetMinAlignment());
+		Property->InitializeValue(Value);
+		Context.Reader.bObjectReferenceSkipped = false;
+		FStructuredArchiveFromArchive StructuredArchive(Ar);
+		Property->SerializeItem(StructuredArchive.GetSlot(), Value, nullptr);
+
+		TSharedPtr<FJsonValue> JsonValue;
+		if (!Context.Reader.bObjectReferenceSkipped && !Ar.IsError() && Ar.Tell() <= EndOffset)
+			JsonValue = FJsonObjectConverter::UPropertyToJsonValue(Property, Value, 0, 0, ExportCallback);
+
+		Property->DestroyValue(Value);
+		FMemory::Free(Value);
+		return JsonValue;
+	}
+
+	// Read the tagged properties from the current position up to the "None" tag into the fields of OutJsonObject.
+	// Defaults is the container the properties were saved against (archetype or the struct value in it).
+	// Values which can't be read are skipped by the size of the tag and added to OutPropertiesToLoad, without it
+	// (inside a struct) the whole value fails. Returns false if the data is not a valid tag stream
+	bool ReadTaggedProperties(FExportContext& Context, const UStruct* Struct, const void* Defaults, bool bObjectFields, int64 EndOffset, FJsonObject& OutJsonObject, TArray<const FCachedProperty*>* OutPropertiesToLoad)
+	{
+		FArchive& Ar = Context.Reader;
+		const FPropertySchema& Schema = FPropertySchemaCache::Get().GetSchema(Struct);
+		while (true)
+		{
+			FPropertyTag Tag;
+			Ar << Tag;
+			if (Ar.IsError() || Context.Linker.IsError())
+				return false;
+			if (Tag.Name.IsNone())
+				return true;
+
+			const int64 ValueOffset = Ar.Tell();
+			if (Tag.Size < 0 || ValueOffset + Tag.Size > EndOffset)
+				return false;
+
+			// Removed property: the loader skips it too
+			const int32* PropertyIndex = Schema.PropertyIndexByName.Find(Tag.Name);
+			if (PropertyIndex == nullptr)
+			{
+				Ar.Seek(ValueOffset + Tag.Size);
+				continue;
+			}
+
+			const FCachedProperty& CachedProperty = Schema.Properties[*PropertyIndex];
+			TSharedPtr<FJsonValue> JsonValue;
+			if (CachedProperty.Property->ArrayDim == 1 && IsTagOfProperty(Tag, CachedProperty.Property))
+			{
+				// Value of bool property is the part of its tag
+				if (CastField<FBoolProperty>(CachedProperty.Property))
+					JsonValue = MakeShared<FJsonValueBoolean>(Tag.BoolVal != 0);
+				else
+					JsonValue = ReadValue(Context, CachedProperty.Property, CachedProperty.GetValuePtr(Defaults), CachedProperty.ExportCallback, ValueOffset + Tag.Size);
+			}
+
+			if (JsonValue && Ar.Tell() == ValueOffset + Tag.Size)
+			{
+				OutJsonObject.SetField(bObjectFields ? CachedProperty.ObjectFieldName : CachedProperty.StructFieldName, JsonValue);
+				JSON_CONVERTER_COUNT(PropertiesConverted, 1);
+			}
+			else if (OutPropertiesToLoad)
+			{
+				OutPropertiesToLoad->Add(&CachedProperty);
+			}
+			else
+			{
+				return false;
+			}
+			Ar.Seek(ValueOffset + Tag.Size);
+		}
+	}
+
+	// Properties of the export into OutJsonObject. Returns false if the export can't be read from the package file
+	bool ReadObjectProperties(FExportContext& Context, int32 ExportIndex, const TSharedRef<FJsonObject>& OutJsonObject)
+	{
+		FLinkerLoad& Linker = Context.Linker;
+		const FObjectExport& Export = Linker.ExportMap[ExportIndex];
+
+		// Only native classes and classes loaded before: the class of the other package is not loaded here
+		if (!Export.ClassIndex.IsImport() || !IsValidIndex(Linker, Export.ClassIndex))
+			return false;
+		UClass* Class = FindObject<UClass>(nullptr, *GetObjectPath(Linker, Export.ClassIndex));
+		if (Class == nullptr)
+			return false;
+
+		// Tagged properties are saved as the difference from the archetype. The archetype must be the class default
+		// object without default sub objects: other templates are not available without loading
+		UObject* Archetype = Class->GetDefaultObject();
+		if (!Export.TemplateIndex.IsNull() && (!IsValidIndex(Linker, Export.TemplateIndex) || GetObjectPath(Linker, Export.TemplateIndex) != Archetype->GetPathName()))
+			return false;
+		TArray<UObject*> DefaultSubobjects;
+		Archetype->GetDefaultSubobjects(DefaultSubobjects);
+		if (DefaultSubobjects.Num() > 0)
+			return false;
+
+		bool bAlreadyInProgress = false;
+		Context.ExportsInProgress.Add(ExportIndex, &bAlreadyInProgress);
+		if (bAlreadyInProgress)
+			return false;
+
+		// Delta: the tagged properties are exactly the values different from the archetype. Otherwise the values
+		// missing in the data are the values of the archetype
+		const FPropertySchema& Schema = FPropertySchemaCache::Get().GetSchema(Class);
+		if (IsExportDelta())
+		{
+			OutJsonObject->SetBoolField(DeltaFieldName, true);
+		}
+		else
+		{
+			for (const FCachedProperty& CachedProperty : Schema.Properties)
+				OutJsonObject->SetField(CachedProperty.ObjectFieldName, FJsonObjectConverter::UPropertyToJsonValue(CachedProperty.Property, CachedProperty.GetValuePtr(Archetype), 0, 0, CachedProperty.ExportCallback));
+		}
+
+		TArray<const FCachedProperty*> PropertiesToLoad;
+		Context.Reader.Seek(Export.SerialOffset);
+		const bool bRead = ReadTaggedProperties(Context, Class, Archetype, true, Export.SerialOffset + Export.SerialSize, *OutJsonObject, &PropertiesToLoad);
+		Context.ExportsInProgress.Remove(ExportIndex);
+		if (!bRead)
+			return false;
+
+		JSON_CONVERTER_COUNT(ObjectsVisited, 1);
+		if (PropertiesToLoad.Num() > 0)
+			Context.PendingLoads.Add({GetObjectPath(Linker, FPackageIndex::FromExport(ExportIndex)), OutJsonObject, MoveTemp(PropertiesToLoad)});
+		return true;
+	}
+}
+
+namespace FJsonLinkerExport
+{
+	EResult ExportObject(const FString& ObjectPath, const TSharedRef<FJsonObject>& OutJsonObject)
+	{
+		using namespace FJsonLinkerExportLocal;
+		check(IsInGameThread());
+
+		// Loaded object is exported from memory, as usual
+		const UObject* LoadedObject = FindObject<UObject>(nullptr, *ObjectPath);
+		if (LoadedObject && !LoadedObject->HasAnyFlags(RF_NeedLoad))
+			return EResult::NotSupported;
+
+		const FString PackageName = FPackageName::ObjectPathToPackageName(ObjectPath);
+		const FName ObjectName(*FPackageName::ObjectPathToObjectName(ObjectPath));
+
+		// The linker of the package which is in use by the loading is not detached after the export
+		const UPackage* ExistingPackage = FindObjectFast<UPackage>(nullptr, FName(*PackageName));
+		const bool bHadLinker = ExistingPackage && ExistingPackage->GetLinker();
+
+		// Only the summary, the name, import and export maps are read, no export is created
+		FLinkerLoad* Linker = nullptr;
+		{
+			FUObjectSerializeContext* LoadContext = FUObjectThreadContext::Get().GetSerializeContext();
+			BeginLoad(LoadContext);
+			Linker = GetPackageLinker(nullptr, *PackageName, LOAD_NoVerify | LOAD_Quiet | LOAD_NoWarn, nullptr, nullptr, nullptr, &LoadContext);
+			EndLoad(Linker ? Linker->GetSerializeContext() : LoadContext);
+		}
+		if (Linker == nullptr || Linker->Loader == nullptr)
+			return EResult::NotSupported;
+
+		// Unversioned properties have no tags, cooked packages have no editor-only data
+		if (Linker->Summary.GetPackageFlags() & (PKG_UnversionedProperties | PKG_Cooked | PKG_FilterEditorOnly))
+			return EResult::NotSupported;
+
+		const int32 ExportIndex = Linker->ExportMap.IndexOfByPredicate([&ObjectName](const FObjectExport& Export)
+		{
+			return Export.OuterIndex.IsNull() && Export.ObjectName == ObjectName;
+		});
+		if (ExportIndex == INDEX_NONE)
+			return EResult::NotSupported;
+
+		FExportContext Context(*Linker);
+		const bool bRead = ReadObjectProperties(Context, ExportIndex, OutJsonObject);
+		if (Linker->IsError())
+		{
+			Linker->ClearError();
+			return EResult::NotSupported;
+		}
+		if (!bRead)
+			return EResult::NotSupported;
+
+		if (Context.PendingLoads.Num() == 0)
+		{
+			// Close the file: the package stays unloaded
+			if (!bHadLinker)
+				ResetLoaders(Linker->LinkerRoot);
+			return EResult::Exported;
+		}
+
+		// Properties which need object instances are converted from the loaded objects, as by ExportObjectProperties
+		for (const FPendingLoad& PendingLoad : Context.PendingLoads)
+		{
+			const UObject* Object = LoadObject<UObject>(nullptr, *PendingLoad.ObjectPath);
+			if (Object == nullptr)
+				return EResult::NotSupported;
+
+			for (const FCachedProperty* CachedProperty : PendingLoad.Properties)
+			{
+				PendingLoad.JsonObject->SetField(CachedProperty->ObjectFieldName, FJsonObjectConverter::UPropertyToJsonValue(CachedProperty->Property, CachedProperty->GetValuePtr(Object), 0, 0, CachedProperty->ExportCallback));
+				JSON_CONVERTER_COUNT(PropertiesConverted, 1);
+			}
+		}
+		return EResult::ExportedWithLoad;
+	}
+}
@@ -0,0 +1,33 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+
+/**
+ * Export of the asset properties straight from its package file ("-LinkerExport").
+ * The package is opened by its linker (summary, name, import and export maps only), the tagged properties of the export
+ * are read from its serialized data, and object references are written as "Class'/Package.Object'" built from the
+ * import/export maps, so neither the asset nor the objects it references are loaded. Instanced sub objects of the same
+ * package are read the same way. Properties which can't be read without object instances (references to sub objects
+ * of other packages, object pointers inside natively serialized structs, changed property types, static arrays) are
+ * taken from the loaded object, the object is loaded only in this case.
+ */
+namespace FJsonLinkerExport
+{
+	enum class EResult : uint8
+	{
+		// All properties are read from the package file
+		Exported,
+		// Some properties are taken from the loaded object
+		ExportedWithLoad,
+		// The object must be loaded and exported as usual (already in memory, cooked or unversioned package, unknown class,
+		// class with default sub objects). OutJsonObject may contain partial data
+		NotSupported,
+	};
+
+	// Export the properties of the asset "/Package/Path.ObjectName" into OutJsonObject as ExportObjectProperties does
+	// (including the "-Delta" mode). Game thread only
+	EResult ExportObject(const FString& ObjectPath, const TSharedRef<FJsonObject>& OutJsonObject);
+}
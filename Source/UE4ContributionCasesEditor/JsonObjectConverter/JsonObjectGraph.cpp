@@ -0,0 +1,197 @@
+#include "JsonObjectGraph.h"
+
+#include "CustomImportCallbackCommandlet.h"
+#include "CustomJsonCallbacks.h"
+#include "ObjectExportPathCache.h"
+#include "Algo/StableSort.h"
+#include "Misc/ScopeExit.h"
+#include "UE4ContributionCasesEditor/SplitFullObjectPathCase/ObjectPathSplitter.h"
+
+namespace FJsonObjectGraphLocal
+{
+	struct FExportContext
+	{
+		TMap<const UObject*, int32> ObjectIds;
+		// Sub objects which have ids, but are not exported yet
+		TArray<const UObject*> Stack;
+	};
+
+	// Bulk export runs ExportObject on worker threads, each thread has its own context
+	thread_local FExportContext* ActiveContext = nullptr;
+
+	struct FImportEntry
+	{
+		FString SubObjectRef;
+		TSharedPtr<FJsonObject> JsonObject;
+		// Number of outers between the sub object and the root object
+		int32 Depth = 0;
+		UObject* Object = nullptr;
+	};
+
+	// Replace { "$ObjectId": N } values by the string references (iterative, the json can be as deep as the object graph)
+	bool ResolveIdReferences(const TArray<TSharedPtr<FJsonValue>*>& InRootSlots, const TMap<int32, FString>& ReferenceById)
+	{
+		using namespace FJsonObjectGraph;
+
+		bool bResult = true;
+		TArray<TSharedPtr<FJsonValue>*> Slots = InRootSlots;
+		while (Slots.Num() > 0)
+		{
+			TSharedPtr<FJsonValue>& Slot = *Slots.Pop(false);
+			if (!Slot.IsValid())
+				continue;
+
+			const TSharedPtr<FJsonObject>* JsonObject;
+			if (Slot->TryGetObject(JsonObject))
+			{
+				int32 ObjectId;
+				if ((*JsonObject)->Values.Num() == 1 && (*JsonObject)->TryGetNumberField(ObjectIdFieldName, ObjectId))
+				{
+					const FString* Reference = ReferenceById.Find(ObjectId);
+					if (!Reference)
+					{
+						UE_LOG(LogDemoJsonCallback, Error, TEXT("Object id %d not found in '%s'."), ObjectId, *ObjectsFieldName);
+						bResult = false;
+					}
+					Slot = Reference ? MakeShared<FJsonValueString>(*Reference) : TSharedPtr<FJsonValue>(MakeShared<FJsonValueNull>());
+					continue;
+				}
+				for (TPair<FString, TSharedPtr<FJsonValue>>& JsonField : (*JsonObject)->Values)
+					Slots.Add(&JsonField.Value);
+				continue;
+			}
+
+			const TArray<TSharedPtr<FJsonValue>>* JsonElements;
+			if (Slot->TryGetArray(JsonElements))
+			{
+				// FJsonValueArray gives only const access, the elements are replaced in place
+				for (TSharedPtr<FJsonValue>& JsonElement : const_cast<TArray<TSharedPtr<FJsonValue>>&>(*JsonElements))
+					Slots.Add(&JsonElement);
+			}
+		}
+		return bResult;
+	}
+}
+
+namespace FJsonObjectGraph
+{
+	void ExportObject(const UObject* Object, const TSharedRef<FJsonObject>& OutJsonObject)
+	{
+		using namespace FJsonObjectGraphLocal;
+
+		FExportContext Context;
+		FExportContext* const PreviousContext = ActiveContext;
+		ActiveContext = &Context;
+		ON_SCOPE_EXIT
+		{
+			ActiveContext = PreviousContext;
+		};
+
+		// Sub objects met here are only queued
+		FCustomCallbacksDemoLocal::ExportObjectProperties(Object, OutJsonObject);
+
+		const TSharedRef<FJsonObject> JsonObjects = MakeShared<FJsonObject>();
+		while (Context.Stack.Num() > 0)
+		{
+			const UObject* SubObject = Context.Stack.Pop(false);
+
+			const TSharedRef<FJsonObject> JsonSubObject = MakeShared<FJsonObject>();
+			JsonSubObject->SetStringField(FCustomCallbacksDemoLocal::CustomAdditionalPropertyName, FObjectExportPathCache::Get().GetExportPath(SubObject));
+			FCustomCallbacksDemoLocal::ExportObjectProperties(SubObject, JsonSubObject);
+			JsonObjects->SetObjectField(FString::FromInt(Context.ObjectIds.FindChecked(SubObject)), JsonSubObject);
+		}
+
+		if (JsonObjects->Values.Num() > 0)
+			OutJsonObject->SetObjectField(ObjectsFieldName, JsonObjects);
+	}
+
+	TSharedPtr<FJsonValue> GetObjectReference(const UObject* Object)
+	{
+		using namespace FJsonObjectGraphLocal;
+
+		if (!ActiveContext)
+			return nullptr;
+
+		int32 ObjectId;
+		if (const int32* ExistingId = ActiveContext->ObjectIds.Find(Object))
+		{
+			ObjectId = *ExistingId;
+		}
+		else
+		{
+			ObjectId = ActiveContext->ObjectIds.Num() + 1;
+			ActiveContext->ObjectIds.Add(Object, ObjectId);
+			ActiveContext->Stack.Add(Object);
+		}
+
+		const TSharedRef<FJsonObject> JsonReference = MakeShared<FJsonObject>();
+		JsonReference->SetNumberField(ObjectIdFieldName, ObjectId);
+		return MakeShared<FJsonValueObject>(JsonReference);
+	}
+
+	bool ImportObject(UObject* Object, const TSharedRef<FJsonObject>& InJsonObject)
+	{
+		using namespace FCustomCallbacksDemoLocal;
+		using namespace FJsonObjectGraphLocal;
+
+		const TSharedPtr<FJsonObject>* JsonObjectsField;
+		if (!InJsonObject->TryGetObjectField(ObjectsFieldName, JsonObjectsField))
+			return ImportObjectProperties(Object, InJsonObject);
+		const TSharedPtr<FJsonObject> JsonObjects = *JsonObjectsField;
+		InJsonObject->RemoveField(ObjectsFieldName);
+
+		bool bResult = true;
+		TMap<int32, FString> ReferenceById;
+		TArray<FImportEntry> Entries;
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& JsonEntry : JsonObjects->Values)
+		{
+			FImportEntry Entry;
+			const TSharedPtr<FJsonObject>* JsonSubObject;
+			if (!JsonEntry.Key.IsNumeric() || !JsonEntry.Value->TryGetObject(JsonSubObject) || !(*JsonSubObject)->TryGetStringField(CustomAdditionalPropertyName, Entry.SubObjectRef))
+			{
+				UE_LOG(LogDemoJsonCallback, Error, TEXT("Invalid entry '%s' of '%s'."), *JsonEntry.Key, *ObjectsFieldName);
+				bResult = false;
+				continue;
+			}
+			Entry.JsonObject = *JsonSubObject;
+
+			const FObjectPathView PathView = FObjectPathSplitter::Split(Entry.SubObjectRef);
+			for (int32 Index = 0; Index < PathView.SubObjectName.Len(); ++Index)
+				Entry.Depth += PathView.SubObjectName[Index] == TEXT('.') ? 1 : 0;
+
+			ReferenceById.Add(FCString::Atoi(*JsonEntry.Key), Entry.SubObjectRef);
+			Entries.Add(MoveTemp(Entry));
+		}
+
+		// Outers are created before their sub objects
+		Algo::StableSortBy(Entries, &FImportEntry::Depth);
+		for (FImportEntry& Entry : Entries)
+		{
+			Entry.Object = CreateInstancedSubObject(Entry.SubObjectRef);
+			if (!Entry.Object)
+			{
+				UE_LOG(LogDemoJsonCallback, Error, TEXT("Unable to create sub object '%s'."), *Entry.SubObjectRef);
+				bResult = false;
+			}
+		}
+
+		// Now every referenced object exists, so the ids are replaced by the ordinary references
+		TArray<TSharedPtr<FJsonValue>*> RootSlots;
+		for (TPair<FString, TSharedPtr<FJsonValue>>& JsonField : InJsonObject->Values)
+			RootSlots.Add(&JsonField.Value);
+		for (FImportEntry& Entry : Entries)
+		{
+			for (TPair<FString, TSharedPtr<FJsonValue>>& JsonField : Entry.JsonObject->Values)
+				RootSlots.Add(&JsonField.Value);
+		}
+		bResult &= ResolveIdReferences(RootSlots, ReferenceById);
+
+		for (const FImportEntry& Entry : Entries)
+		{
+			if (Entry.Object)
+				bResult &= ImportObjectProperties(Entry.Object, Entry.JsonObject.ToSharedRef());
+		}
+		bResult &= ImportObjectProperties(Object, InJsonObject);
+		return bResult;
+	}
+}
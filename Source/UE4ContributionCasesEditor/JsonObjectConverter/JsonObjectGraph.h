@@ -0,0 +1,32 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+
+/**
+ * Graph-aware export of the object with its instanced sub objects ("-ObjectGraph").
+ * Sub objects are not exported in place by the nested ObjectJsonCallback calls: each of them gets an id, the reference
+ * becomes { "$ObjectId": N }, and the properties are exported once into the table field of the root object
+ *   "$Objects": { "1": { "SubObjectRef": "Class'/Package.Object:SubObject'", ... }, ... }
+ * by a loop over the explicit work stack. Shared sub objects and cycles are exported once, deep chains of instanced
+ * objects don't grow the call stack.
+ */
+namespace FJsonObjectGraph
+{
+	static const FString ObjectsFieldName = TEXT("$Objects");
+	static const FString ObjectIdFieldName = TEXT("$ObjectId");
+
+	// Export properties of the Object and all its instanced sub objects into OutJsonObject
+	void ExportObject(const UObject* Object, const TSharedRef<FJsonObject>& OutJsonObject);
+
+	// Id reference of the instanced sub object while ExportObject is running on this thread (the object is queued
+	// for export on the first call), nullptr otherwise
+	TSharedPtr<FJsonValue> GetObjectReference(const UObject* Object);
+
+	// Create the sub objects of the table (outers first), replace the id references by the references of created
+	// objects and import the properties. The table field is removed from InJsonObject.
+	// Returns false if the table, a reference or a property is invalid
+	bool ImportObject(UObject* Object, const TSharedRef<FJsonObject>& InJsonObject);
+}
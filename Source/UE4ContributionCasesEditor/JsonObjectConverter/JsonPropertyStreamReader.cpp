@@ -0,0 +1,446 @@
+#include "JsonPropertyStreamReader.h"
+
+#include "CustomImportCallbackCommandlet.h"
+#include "CustomJsonCallbacks.h"
+#include "JsonConverterStats.h"
+#include "PropertySchemaCache.h"
+
+namespace FJsonPropertyStreamReaderLocal
+{
+	/**
+	 * TJsonReader reads characters one by one, so the file is decoded into TCHAR on the fly by this archive.
+	 * UTF-8 by default; UTF-8 and UTF-16 (LE/BE) byte order marks are detected at the start of the file,
+	 * because FFileHelper::SaveStringToFile writes UTF-16 with BOM when the text is not ANSI
+	 */
+	class FTextDecoderArchive : public FArchive
+	{
+	public:
+		explicit FTextDecoderArchive(FArchive* InInner)
+			: Inner(InInner)
+		{
+			SetIsLoading(true);
+		}
+
+		virtual void Serialize(void* Data, int64 Num) override
+		{
+			check(Num % sizeof(TCHAR) == 0);
+			if (Encoding == EEncoding::Unknown)
+				DetectEncoding();
+
+			TCHAR* OutChars = static_cast<TCHAR*>(Data);
+			for (int64 Index = 0; Index < Num / int64(sizeof(TCHAR)); ++Index)
+				OutChars[Index] = Encoding == EEncoding::Utf8 ? ReadUtf8Char() : ReadUtf16Char();
+		}
+
+		virtual int64 TotalSize() override
+		{
+			return Inner->TotalSize();
+		}
+
+		virtual int64 Tell() override
+		{
+			return Inner->Tell() - (BufferNum - BufferPos);
+		}
+
+		virtual bool AtEnd() override
+		{
+			return PendingLowSurrogate == 0 && BufferPos == BufferNum && Inner->AtEnd();
+		}
+
+	private:
+		enum class EEncoding : uint8
+		{
+			Unknown,
+			Utf8,
+			Utf16LE,
+			Utf16BE,
+		};
+
+		bool FillBuffer()
+		{
+			BufferPos = 0;
+			BufferNum = FMath::Min<int64>(UE_ARRAY_COUNT(Buffer), Inner->TotalSize() - Inner->Tell());
+			if (BufferNum <= 0)
+			{
+				BufferNum = 0;
+				return false;
+			}
+			Inner->Serialize(Buffer, BufferNum);
+			return true;
+		}
+
+		// The byte order mark is skipped, the file without it is UTF-8
+		void DetectEncoding()
+		{
+			Encoding = EEncoding::Utf8;
+			if (BufferPos == BufferNum && !FillBuffer())
+				return;
+
+			const int64 NumBytes = BufferNum - BufferPos;
+			const uint8* Bytes = Buffer + BufferPos;
+			if (NumBytes >= 3 && Bytes[0] == 0xEF && Bytes[1] == 0xBB && Bytes[2] == 0xBF)
+			{
+				BufferPos += 3;
+			}
+			else if (NumBytes >= 2 && Bytes[0] == 0xFF && Bytes[1] == 0xFE)
+			{
+				Encoding = EEncoding::Utf16LE;
+				BufferPos += 2;
+			}
+			else if (NumBytes >= 2 && Bytes[0] == 0xFE && Bytes[1] == 0xFF)
+			{
+				Encoding = EEncoding::Utf16BE;
+				BufferPos += 2;
+			}
+		}
+
+		uint8 ReadByte()
+		{
+			if (BufferPos == BufferNum && !FillBuffer())
+			{
+				SetError();
+				return 0;
+			}
+			return Buffer[BufferPos++];
+		}
+
+		TCHAR ReadUtf8Char()
+		{
+			if (PendingLowSurrogate)
+			{
+				const TCHAR Result = PendingLowSurrogate;
+				PendingLowSurrogate = 0;
+				return Result;
+			}
+
+			const uint8 Lead = ReadByte();
+			if (Lead < 0x80)
+				return TCHAR(Lead);
+
+			const int32 NumTrail = Lead >= 0xF0 ? 3 : (Lead >= 0xE0 ? 2 : 1);
+			uint32 CodePoint = Lead & (0x3F >> NumTrail);
+			for (int32 Trail = 0; Trail < NumTrail; ++Trail)
+				CodePoint = (CodePoint << 6) | (ReadByte() & 0x3F);
+
+			// Code points outside of BMP are split into surrogate pair for 2 bytes TCHAR
+			if (sizeof(TCHAR) == 2 && CodePoint > 0xFFFF)
+			{
+				CodePoint -= 0x10000;
+				PendingLowSurrogate = TCHAR(0xDC00 + (CodePoint & 0x3FF));
+				return TCHAR(0xD800 + (CodePoint >> 10));
+			}
+			return TCHAR(CodePoint);
+		}
+
+		uint32 ReadUtf16CodeUnit()
+		{
+			const uint32 First = ReadByte();
+			const uint32 Second = ReadByte();
+			return Encoding == EEncoding::Utf16BE ? (First << 8) | Second : (Second << 8) | First;
+		}
+
+		TCHAR ReadUtf16Char()
+		{
+			const uint32 CodeUnit = ReadUtf16CodeUnit();
+			// Surrogate pair is combined into one code point for 4 bytes TCHAR
+			if (sizeof(TCHAR) == 4 && CodeUnit >= 0xD800 && CodeUnit < 0xDC00)
+				return TCHAR(0x10000 + ((CodeUnit - 0xD800) << 10) + ((ReadUtf16CodeUnit() - 0xDC00) & 0x3FF));
+			return TCHAR(CodeUnit);
+		}
+
+		FArchive* Inner;
+		uint8 Buffer[64 * 1024];
+		int64 BufferPos = 0;
+		int64 BufferNum = 0;
+		TCHAR PendingLowSurrogate = 0;
+		EEncoding Encoding = EEncoding::Unknown;
+	};
+}
+
+FJsonPropertyStreamReader::FJsonPropertyStreamReader(FArchive* InArchive)
+	: TextDecoder(MakeUnique<FJsonPropertyStreamReaderLocal::FTextDecoderArchive>(InArchive))
+	, JsonReader(TJsonReader<TCHAR>::Create(TextDecoder.Get()))
+{
+}
+
+FJsonPropertyStreamReader::~FJsonPropertyStreamReader()
+{
+}
+
+bool FJsonPropertyStreamReader::ReadObject(UObject* Object)
+{
+	EJsonNotation Notation;
+	if (!JsonReader->ReadNext(Notation) || Notation != EJsonNotation::ObjectStart)
+		return SetError(TEXT("Json object expected"));
+
+	JSON_CONVERTER_COUNT(ObjectsVisited, 1);
+	return ReadStructFields(Object->GetClass(), Object);
+}
+
+bool FJsonPropertyStreamReader::ReadStructFields(const UStruct* Struct, void* Data)
+{
+	const FPropertySchema& Schema = FPropertySchemaCache::Get().GetSchema(Struct);
+	// Object written in delta mode: the properties missing in json are reset to the archetype at the end of the object
+	const bool bIsObject = Struct->IsA<UClass>();
+	bool bDelta = false;
+	TBitArray<> PresentProperties;
+	if (bIsObject)
+		PresentProperties.Init(false, Schema.Properties.Num());
+
+	EJsonNotation Notation;
+	while (JsonReader->ReadNext(Notation))
+	{
+		if (Notation == EJsonNotation::ObjectEnd)
+		{
+			if (bDelta)
+				FCustomCallbacksDemoLocal::ResetMissingPropertiesToArchetype(static_cast<UObject*>(Data), PresentProperties);
+			return true;
+		}
+		if (Notation == EJsonNotation::Error)
+			break;
+
+		const FString& Identifier = JsonReader->GetIdentifier();
+		if (bIsObject && Identifier == FCustomCallbacksDemoLocal::DeltaFieldName)
+		{
+			bDelta = Notation == EJsonNotation::Boolean && JsonReader->GetValueAsBoolean();
+			if (!SkipValue(Notation))
+				return false;
+			continue;
+		}
+
+		const FCachedProperty* CachedProperty = Schema.FindProperty(Identifier);
+		if (CachedProperty == nullptr)
+		{
+			// Additional custom fields are not properties
+			if (!FCustomCallbacksDemoLocal::IsRecordMetadataField(Identifier))
+				UE_LOG(LogDemoJsonCallback, Error, TEXT("Property '%s' not found in %s. Property skipped."), *Identifier, *Struct->GetName());
+			if (!SkipValue(Notation))
+				return false;
+			continue;
+		}
+
+		if (bIsObject)
+		{
+			JSON_CONVERTER_COUNT(PropertiesConverted, 1);
+			PresentProperties[CachedProperty - Schema.Properties.GetData()] = true;
+		}
+
+		if (!ReadPropertyValue(Notation, CachedProperty->Property, CachedProperty->GetValuePtr(Data)))
+			return false;
+	}
+
+	return SetError(JsonReader->GetErrorMessage());
+}
+
+bool FJsonPropertyStreamReader::ReadInstancedObject(FObjectProperty* Property, void* Value)
+{
+	using namespace FCustomCallbacksDemoLocal;
+
+	// The reference on the instanced object must go first, before its properties
+	EJsonNotation Notation;
+	if (!JsonReader->ReadNext(Notation) || Notation != EJsonNotation::String || JsonReader->GetIdentifier() != CustomAdditionalPropertyName)
+		return SetError(FString::Printf(TEXT("'%s' expected as the first field of object for property '%s'"), *CustomAdditionalPropertyName, *Property->GetName()));
+
+	UObject* SubObject = CreateInstancedSubObject(JsonReader->GetValueAsString());
+	if (SubObject == nullptr)
+		return SetError(FString::Printf(TEXT("'%s' is not a reference on instanced object"), *JsonReader->GetValueAsString()));
+	JSON_CONVERTER_COUNT(ObjectsVisited, 1);
+
+	if (!ReadStructFields(SubObject->GetClass(), SubObject))
+		return false;
+
+	// After the properties for the sub object are restored, write a link to this object in the current property
+	Property->SetObjectPropertyValue(Value, SubObject);
+	return true;
+}
+
+bool FJsonPropertyStreamReader::ReadPropertyValue(EJsonNotation Notation, FProperty* Property, void* Value)
+{
+	if (Property->ArrayDim == 1 || Notation != EJsonNotation::ArrayStart)
+		return ReadScalarValue(Notation, Property, Value);
+
+	// Static array
+	for (int32 Index = 0; JsonReader->ReadNext(Notation); ++Index)
+	{
+		if (Notation == EJsonNotation::ArrayEnd)
+			return true;
+		if (Index >= Property->ArrayDim)
+			return SetError(FString::Printf(TEXT("Too many elements for static array '%s'"), *Property->GetName()));
+		if (!ReadScalarValue(Notation, Property, static_cast<uint8*>(Value) + Index * Property->ElementSize))
+			return false;
+	}
+	return SetError(JsonReader->GetErrorMessage());
+}
+
+bool FJsonPropertyStreamReader::ReadScalarValue(EJsonNotation Notation, FProperty* Property, void* Value)
+{
+	switch (Notation)
+	{
+	case EJsonNotation::Null:
+		if (FObjectPropertyBase* ObjectProperty = CastField<FObjectPropertyBase>(Property))
+			ObjectProperty->SetObjectPropertyValue(Value, nullptr);
+		return true;
+
+	case EJsonNotation::Boolean:
+		if (FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property))
+		{
+			BoolProperty->SetPropertyValue(Value, JsonReader->GetValueAsBoolean());
+			return true;
+		}
+		return ImportStringValue(JsonReader->GetValueAsBoolean() ? TEXT("true") : TEXT("false"), Property, Value);
+
+	case EJsonNotation::Number:
+		if (FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+		{
+			if (NumericProperty->IsFloatingPoint())
+				NumericProperty->SetFloatingPointPropertyValue(Value, JsonReader->GetValueAsNumber());
+			else
+				NumericProperty->SetIntPropertyValue(Value, static_cast<int64>(JsonReader->GetValueAsNumber()));
+			return true;
+		}
+		return ImportStringValue(FString::SanitizeFloat(JsonReader->GetValueAsNumber(), 0), Property, Value);
+
+	case EJsonNotation::String:
+		return ImportStringValue(JsonReader->GetValueAsString(), Property, Value);
+
+	case EJsonNotation::ArrayStart:
+		return ReadArrayValue(Property, Value);
+
+	case EJsonNotation::ObjectStart:
+		if (FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+			return ReadStructFields(StructProperty->Struct, Value);
+		if (FObjectProperty* ObjectProperty = CastField<FObjectProperty>(Property))
+			return ReadInstancedObject(ObjectProperty, Value);
+		if (FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+			return ReadMapValue(MapProperty, Value);
+		return SetError(FString::Printf(TEXT("Unexpected json object for property '%s'"), *Property->GetName()));
+
+	default:
+		return SetError(JsonReader->GetErrorMessage());
+	}
+}
+
+bool FJsonPropertyStreamReader::ReadArrayValue(FProperty* Property, void* Value)
+{
+	EJsonNotation Notation;
+	if (FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+	{
+		FScriptArrayHelper Helper(ArrayProperty, Value);
+		Helper.EmptyValues();
+		while (JsonReader->ReadNext(Notation))
+		{
+			if (Notation == EJsonNotation::ArrayEnd)
+				return true;
+			const int32 Index = Helper.AddValue();
+			if (!ReadPropertyValue(Notation, ArrayProperty->Inner, Helper.GetRawPtr(Index)))
+				return false;
+		}
+		return SetError(JsonReader->GetErrorMessage());
+	}
+
+	if (FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+	{
+		FScriptSetHelper Helper(SetProperty, Value);
+		Helper.EmptyElements();
+		while (JsonReader->ReadNext(Notation))
+		{
+			if (Notation == EJsonNotation::ArrayEnd)
+			{
+				Helper.Rehash();
+				return true;
+			}
+			const int32 Index = Helper.AddDefaultValue_Invalid_NeedsRehash();
+			if (!ReadPropertyValue(Notation, SetProperty->ElementProp, Helper.GetElementPtr(Index)))
+				return false;
+		}
+		return SetError(JsonReader->GetErrorMessage());
+	}
+
+	return SetError(FString::Printf(TEXT("Unexpected json array for property '%s'"), *Property->GetName()));
+}
+
+bool FJsonPropertyStreamReader::ReadMapValue(FMapProperty* Property, void* Value)
+{
+	FScriptMapHelper Helper(Property, Value);
+	Helper.EmptyValues();
+
+	EJsonNotation Notation;
+	while (JsonReader->ReadNext(Notation))
+	{
+		if (Notation == EJsonNotation::ObjectEnd)
+		{
+			Helper.Rehash();
+			return true;
+		}
+
+		const int32 Index = Helper.AddDefaultValue_Invalid_NeedsRehash();
+		if (!ImportStringValue(JsonReader->GetIdentifier(), Property->KeyProp, Helper.GetKeyPtr(Index)))
+			return false;
+		if (!ReadPropertyValue(Notation, Property->ValueProp, Helper.GetValuePtr(Index)))
+			return false;
+	}
+	return SetError(JsonReader->GetErrorMessage());
+}
+
+bool FJsonPropertyStreamReader::ImportStringValue(const FString& StringValue, FProperty* Property, void* Value)
+{
+	if (FStrProperty* StringProperty = CastField<FStrProperty>(Property))
+	{
+		StringProperty->SetPropertyValue(Value, StringValue);
+		return true;
+	}
+	if (FNameProperty* NameProperty = CastField<FNameProperty>(Property))
+	{
+		NameProperty->SetPropertyValue(Value, FName(*StringValue));
+		return true;
+	}
+	if (FTextProperty* TextProperty = CastField<FTextProperty>(Property))
+	{
+		TextProperty->SetPropertyValue(Value, FText::FromString(StringValue));
+		return true;
+	}
+	if (FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+	{
+		// Enums are exported as strings
+		const int64 EnumValue = EnumProperty->GetEnum()->GetValueByNameString(StringValue);
+		if (EnumValue == INDEX_NONE)
+			return SetError(FString::Printf(TEXT("Unable to import enum '%s' from string value '%s'"), *EnumProperty->GetEnum()->GetName(), *StringValue));
+		EnumProperty->GetUnderlyingProperty()->SetIntPropertyValue(Value, EnumValue);
+		return true;
+	}
+	if (FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+	{
+		if (UEnum* EnumDef = NumericProperty->GetIntPropertyEnum())
+		{
+			const int64 EnumValue = EnumDef->GetValueByNameString(StringValue);
+			if (EnumValue == INDEX_NONE)
+				return SetError(FString::Printf(TEXT("Unable to import enum '%s' from string value '%s'"), *EnumDef->GetName(), *StringValue));
+			NumericProperty->SetIntPropertyValue(Value, EnumValue);
+			return true;
+		}
+		NumericProperty->SetNumericPropertyValueFromString(Value, *StringValue);
+		return true;
+	}
+
+	// Object references and structs with native ImportTextItem are exported as text
+	if (Property->ImportText(*StringValue, Value, PPF_None, nullptr) == nullptr)
+		return SetError(FString::Printf(TEXT("Unable to import property '%s' from string value '%s'"), *Property->GetName(), *StringValue));
+	return true;
+}
+
+bool FJsonPropertyStreamReader::SkipValue(EJsonNotation Notation)
+{
+	bool bResult = true;
+	if (Notation == EJsonNotation::ObjectStart)
+		bResult = JsonReader->SkipObject();
+	else if (Notation == EJsonNotation::ArrayStart)
+		bResult = JsonReader->SkipArray();
+	return bResult || SetError(JsonReader->GetErrorMessage());
+}
+
+bool FJsonPropertyStreamReader::SetError(const FString& InMessage)
+{
+	if (ErrorMessage.IsEmpty())
+		ErrorMessage = FString::Printf(TEXT("%s (line %d, character %d)"), *InMessage, JsonReader->GetLineNumber(), JsonReader->GetCharacterNumber());
+	return false;
+}
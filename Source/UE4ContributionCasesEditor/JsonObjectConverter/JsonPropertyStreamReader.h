@@ -0,0 +1,45 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Serialization/JsonReader.h"
+
+/**
+ * Pull-parser import: reads json tokens from an UTF-8 (or UTF-16 with BOM) archive and writes values straight into the property memory,
+ * without FJsonValue tree. Supports the "SubObjectRef" convention for instanced sub objects
+ * (the reference must be the first field of the json object, as FJsonPropertyStreamWriter and ObjectJsonCallback write it).
+ */
+class FJsonPropertyStreamReader
+{
+public:
+	explicit FJsonPropertyStreamReader(FArchive* InArchive);
+	~FJsonPropertyStreamReader();
+
+	// Read the json object from the stream into the properties of the Object
+	bool ReadObject(UObject* Object);
+
+	const FString& GetErrorMessage() const { return ErrorMessage; }
+
+private:
+	// Read fields of json object (after ObjectStart) into the properties of the struct
+	bool ReadStructFields(const UStruct* Struct, void* Data);
+	// Read fields of json object with "SubObjectRef" (after ObjectStart) into the object property
+	bool ReadInstancedObject(FObjectProperty* Property, void* Value);
+
+	// Read the value which starts with Notation into the property
+	bool ReadPropertyValue(EJsonNotation Notation, FProperty* Property, void* Value);
+	bool ReadScalarValue(EJsonNotation Notation, FProperty* Property, void* Value);
+	bool ReadArrayValue(FProperty* Property, void* Value);
+	bool ReadMapValue(FMapProperty* Property, void* Value);
+	bool ImportStringValue(const FString& StringValue, FProperty* Property, void* Value);
+
+	// Skip the value which starts with Notation
+	bool SkipValue(EJsonNotation Notation);
+
+	bool SetError(const FString& InMessage);
+
+	TUniquePtr<FArchive> TextDecoder;
+	TSharedRef<TJsonReader<TCHAR>> JsonReader;
+	FString ErrorMessage;
+};
@@ -0,0 +1,220 @@
+#include "JsonPropertyStreamWriter.h"
+
+#include "CustomImportCallbackCommandlet.h"
+#include "CustomJsonCallbacks.h"
+#include "JsonConverterStats.h"
+#include "JsonObjectConverter.h"
+#include "PropertySchemaCache.h"
+
+FJsonPropertyStreamWriter::FJsonPropertyStreamWriter(FArchive* InArchive)
+	: JsonWriter(TJsonWriterFactory<UTF8CHAR, TPrettyJsonPrintPolicy<UTF8CHAR>>::Create(InArchive))
+{
+}
+
+void FJsonPropertyStreamWriter::WriteObject(const UObject* Object, const FString& InAssetRef)
+{
+	JsonWriter->WriteObjectStart();
+	if (!InAssetRef.IsEmpty())
+		JsonWriter->WriteValue(FCustomCallbacksDemoLocal::AssetRefPropertyName, InAssetRef);
+	WriteObjectProperties(Object);
+	JsonWriter->WriteObjectEnd();
+}
+
+bool FJsonPropertyStreamWriter::Close()
+{
+	return JsonWriter->Close();
+}
+
+void FJsonPropertyStreamWriter::WriteObjectProperties(const UObject* Object)
+{
+	// Top level properties of the object are named as in ExportObjectProperties (without StandardizeCase)
+	const FPropertySchema& Schema = FPropertySchemaCache::Get().GetSchema(Object->GetClass());
+	for (const FCachedProperty& CachedProperty : Schema.Properties)
+		WriteProperty(CachedProperty.Property, CachedProperty.GetValuePtr(Object), &CachedProperty.ObjectFieldName);
+
+	JSON_CONVERTER_COUNT(ObjectsVisited, 1);
+	JSON_CONVERTER_COUNT(PropertiesConverted, Schema.Properties.Num());
+}
+
+void FJsonPropertyStreamWriter::WriteStructProperties(const UStruct* Struct, const void* Data)
+{
+	const FPropertySchema& Schema = FPropertySchemaCache::Get().GetSchema(Struct);
+	for (const FCachedProperty& CachedProperty : Schema.Properties)
+	{
+		// The same default skip flags as FJsonObjectConverter::UStructToJsonAttributes
+		if (CachedProperty.Property->HasAnyPropertyFlags(CPF_Deprecated | CPF_Transient))
+			continue;
+
+		WriteProperty(CachedProperty.Property, CachedProperty.GetValuePtr(Data), &CachedProperty.StructFieldName);
+	}
+}
+
+void FJsonPropertyStreamWriter::WriteProperty(FProperty* Property, const void* Value, const FString* Identifier)
+{
+	if (Property->ArrayDim == 1)
+	{
+		WriteScalarProperty(Property, Value, Identifier);
+		return;
+	}
+
+	// Static array
+	WriteArrayStart(Identifier);
+	for (int32 Index = 0; Index < Property->ArrayDim; ++Index)
+		WriteScalarProperty(Property, static_cast<const uint8*>(Value) + Index * Property->ElementSize, nullptr);
+	JsonWriter->WriteArrayEnd();
+}
+
+void FJsonPropertyStreamWriter::WriteScalarProperty(FProperty* Property, const void* Value, const FString* Identifier)
+{
+	using namespace FCustomCallbacksDemoLocal;
+
+	// Instead of CustomExportCallback (ObjectJsonCallback)
+	if (CastField<FObjectProperty>(Property))
+	{
+		FString ReferenceString;
+		FString Error;
+		const UObject* SubObject = ResolveInstancedSubObject(Property, Value, ReferenceString, Error);
+		if (!Error.IsEmpty() && ErrorMessage.IsEmpty())
+			ErrorMessage = Error;
+		if (!SubObject)
+		{
+			WriteString(ReferenceString, Identifier);
+			return;
+		}
+
+		WriteObjectStart(Identifier);
+		JsonWriter->WriteValue(CustomAdditionalPropertyName, ReferenceString);
+		WriteObjectProperties(SubObject);
+		JsonWriter->WriteObjectEnd();
+		return;
+	}
+
+	if (FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+	{
+		// Export enums as strings
+		const int64 EnumValue = EnumProperty->GetUnderlyingProperty()->GetSignedIntPropertyValue(Value);
+		WriteString(EnumProperty->GetEnum()->GetNameStringByValue(EnumValue), Identifier);
+	}
+	else if (FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+	{
+		if (UEnum* EnumDef = NumericProperty->GetIntPropertyEnum())
+			WriteString(EnumDef->GetNameStringByValue(NumericProperty->GetSignedIntPropertyValue(Value)), Identifier);
+		else if (NumericProperty->IsFloatingPoint())
+			WriteNumber(NumericProperty->GetFloatingPointPropertyValue(Value), Identifier);
+		else
+			WriteNumber(NumericProperty->GetSignedIntPropertyValue(Value), Identifier);
+	}
+	else if (FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property))
+	{
+		if (Identifier)
+			JsonWriter->WriteValue(*Identifier, BoolProperty->GetPropertyValue(Value));
+		else
+			JsonWriter->WriteValue(BoolProperty->GetPropertyValue(Value));
+	}
+	else if (FStrProperty* StringProperty = CastField<FStrProperty>(Property))
+	{
+		WriteString(StringProperty->GetPropertyValue(Value), Identifier);
+	}
+	else if (FTextProperty* TextProperty = CastField<FTextProperty>(Property))
+	{
+		WriteString(TextProperty->GetPropertyValue(Value).ToString(), Identifier);
+	}
+	else if (FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+	{
+		WriteArrayStart(Identifier);
+		FScriptArrayHelper Helper(ArrayProperty, Value);
+		for (int32 Index = 0; Index < Helper.Num(); ++Index)
+			WriteProperty(ArrayProperty->Inner, Helper.GetRawPtr(Index), nullptr);
+		JsonWriter->WriteArrayEnd();
+	}
+	else if (FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+	{
+		WriteArrayStart(Identifier);
+		FScriptSetHelper Helper(SetProperty, Value);
+		for (int32 Index = 0, Num = Helper.Num(); Num; ++Index)
+		{
+			if (!Helper.IsValidIndex(Index))
+				continue;
+			WriteProperty(SetProperty->ElementProp, Helper.GetElementPtr(Index), nullptr);
+			--Num;
+		}
+		JsonWriter->WriteArrayEnd();
+	}
+	else if (FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+	{
+		WriteObjectStart(Identifier);
+		FScriptMapHelper Helper(MapProperty, Value);
+		for (int32 Index = 0, Num = Helper.Num(); Num; ++Index)
+		{
+			if (!Helper.IsValidIndex(Index))
+				continue;
+
+			// Json keys are always strings
+			FString KeyString;
+			FProperty* KeyProperty = MapProperty->KeyProp;
+			if (FStrProperty* KeyStringProperty = CastField<FStrProperty>(KeyProperty))
+				KeyString = KeyStringProperty->GetPropertyValue(Helper.GetKeyPtr(Index));
+			else
+				KeyProperty->ExportTextItem(KeyString, Helper.GetKeyPtr(Index), nullptr, nullptr, PPF_None);
+
+			WriteProperty(MapProperty->ValueProp, Helper.GetValuePtr(Index), &KeyString);
+			--Num;
+		}
+		JsonWriter->WriteObjectEnd();
+	}
+	else if (FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+	{
+		// Structs with native ExportTextItem are exported as strings (as in FJsonObjectConverter)
+		UScriptStruct::ICppStructOps* CppStructOps = StructProperty->Struct->GetCppStructOps();
+		if (CppStructOps && CppStructOps->HasExportTextItem())
+		{
+			FString StringValue;
+			CppStructOps->ExportTextItem(StringValue, Value, nullptr, nullptr, PPF_None, nullptr);
+			WriteString(StringValue, Identifier);
+			return;
+		}
+
+		WriteObjectStart(Identifier);
+		WriteStructProperties(StructProperty->Struct, Value);
+		JsonWriter->WriteObjectEnd();
+	}
+	else
+	{
+		// Default to export as string for everything else
+		FString StringValue;
+		Property->ExportTextItem(StringValue, Value, nullptr, nullptr, PPF_None);
+		WriteString(StringValue, Identifier);
+	}
+}
+
+void FJsonPropertyStreamWriter::WriteString(const FString& Value, const FString* Identifier)
+{
+	if (Identifier)
+		JsonWriter->WriteValue(*Identifier, Value);
+	else
+		JsonWriter->WriteValue(Value);
+}
+
+void FJsonPropertyStreamWriter::WriteNumber(double Value, const FString* Identifier)
+{
+	if (Identifier)
+		JsonWriter->WriteValue(*Identifier, Value);
+	else
+		JsonWriter->WriteValue(Value);
+}
+
+void FJsonPropertyStreamWriter::WriteObjectStart(const FString* Identifier)
+{
+	if (Identifier)
+		JsonWriter->WriteObjectStart(*Identifier);
+	else
+		JsonWriter->WriteObjectStart();
+}
+
+void FJsonPropertyStreamWriter::WriteArrayStart(const FString* Identifier)
+{
+	if (Identifier)
+		JsonWriter->WriteArrayStart(*Identifier);
+	else
+		JsonWriter->WriteArrayStart();
+}
@@ -0,0 +1,43 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Policies/PrettyJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+
+/**
+ * Writes object properties straight into an archive as UTF-8 json while walking TFieldIterator<FProperty>.
+ * No intermediate FJsonObject tree or FString is built, so the memory does not depend on the asset size.
+ * The output is the same as ExportObjectProperties (FJsonObjectConverter::UPropertyToJsonValue + ObjectJsonCallback),
+ * including the "SubObjectRef" convention for instanced sub objects.
+ */
+class FJsonPropertyStreamWriter
+{
+public:
+	explicit FJsonPropertyStreamWriter(FArchive* InArchive);
+
+	// Write json object with all properties of the Object. If InAssetRef is not empty, it is written first as "AssetRef" field
+	void WriteObject(const UObject* Object, const FString& InAssetRef = FString());
+
+	// Close the writer. Returns false if the written json is not complete
+	bool Close();
+
+	// The first problem of the written data (e.g. instanced sub object not in memory on a worker thread), empty if none
+	const FString& GetErrorMessage() const { return ErrorMessage; }
+
+private:
+	void WriteObjectProperties(const UObject* Object);
+	void WriteStructProperties(const UStruct* Struct, const void* Data);
+
+	// Identifier == nullptr - value is an element of json array
+	void WriteProperty(FProperty* Property, const void* Value, const FString* Identifier);
+	void WriteScalarProperty(FProperty* Property, const void* Value, const FString* Identifier);
+	void WriteString(const FString& Value, const FString* Identifier);
+	void WriteNumber(double Value, const FString* Identifier);
+	void WriteObjectStart(const FString* Identifier);
+	void WriteArrayStart(const FString* Identifier);
+
+	TSharedRef<TJsonWriter<UTF8CHAR, TPrettyJsonPrintPolicy<UTF8CHAR>>> JsonWriter;
+	FString ErrorMessage;
+};
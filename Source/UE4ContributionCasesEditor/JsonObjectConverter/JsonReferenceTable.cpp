@@ -0,0 +1,236 @@
+#include "JsonReferenceTable.h"
+
+#include "CustomImportCallbackCommandlet.h"
+
+namespace FJsonReferenceTableLocal
+{
+	static const TCHAR EncodedPrefix = TEXT('@');
+
+	struct FTableBuilder
+	{
+		TArray<FString> Classes;
+		TArray<FString> Packages;
+		TMap<FString, int32> ClassIndices;
+		TMap<FString, int32> PackageIndices;
+
+		int32 Intern(const FString& InValue, TArray<FString>& Values, TMap<FString, int32>& Indices)
+		{
+			if (const int32* Index = Indices.Find(InValue))
+				return *Index;
+			return Indices.Add(InValue, Values.Add(InValue));
+		}
+
+		// Encoded reference or the escaped string
+		FString Encode(const FString& InValue)
+		{
+			if (InValue.Len() > 0 && InValue[0] == EncodedPrefix)
+				return TEXT("@") + InValue;
+
+			// "Class'/Package.Object:SubObject'"
+			int32 QuoteIndex;
+			if (InValue.Len() < 4 || InValue[InValue.Len() - 1] != TEXT('\'') || !InValue.FindChar(TEXT('\''), QuoteIndex)
+				|| QuoteIndex == 0 || QuoteIndex >= InValue.Len() - 2 || InValue[QuoteIndex + 1] != TEXT('/'))
+				return InValue;
+
+			const FString ClassName = InValue.Left(QuoteIndex);
+			if (ClassName.Contains(TEXT(" ")) || ClassName.Contains(TEXT("/")))
+				return InValue;
+
+			// Package path ends before the object name
+			const int32 PackageStart = QuoteIndex + 1;
+			const int32 ContentEnd = InValue.Len() - 1;
+			int32 PackageEnd = InValue.Find(TEXT("."), ESearchCase::CaseSensitive, ESearchDir::FromStart, PackageStart);
+			if (PackageEnd == INDEX_NONE || PackageEnd > ContentEnd)
+				PackageEnd = ContentEnd;
+
+			const int32 ClassIndex = Intern(ClassName, Classes, ClassIndices);
+			const int32 PackageIndex = Intern(InValue.Mid(PackageStart, PackageEnd - PackageStart), Packages, PackageIndices);
+			return FString::Printf(TEXT("%c%d:%d"), EncodedPrefix, ClassIndex, PackageIndex) + InValue.Mid(PackageEnd, ContentEnd - PackageEnd);
+		}
+	};
+
+	TSharedPtr<FJsonValue> InternValue(const TSharedPtr<FJsonValue>& Value, FTableBuilder& Table);
+
+	void InternObject(const TSharedPtr<FJsonObject>& JsonObject, FTableBuilder& Table)
+	{
+		for (TPair<FString, TSharedPtr<FJsonValue>>& Field : JsonObject->Values)
+			Field.Value = InternValue(Field.Value, Table);
+	}
+
+	TSharedPtr<FJsonValue> InternValue(const TSharedPtr<FJsonValue>& Value, FTableBuilder& Table)
+	{
+		if (!Value.IsValid())
+			return Value;
+
+		switch (Value->Type)
+		{
+		case EJson::String:
+			return MakeShared<FJsonValueString>(Table.Encode(Value->AsString()));
+		case EJson::Array:
+		{
+			TArray<TSharedPtr<FJsonValue>> Elements;
+			Elements.Reserve(Value->AsArray().Num());
+			for (const TSharedPtr<FJsonValue>& Element : Value->AsArray())
+				Elements.Add(InternValue(Element, Table));
+			return MakeShared<FJsonValueArray>(Elements);
+		}
+		case EJson::Object:
+			InternObject(Value->AsObject(), Table);
+			return Value;
+		default:
+			return Value;
+		}
+	}
+
+	// Escaped strings are arbitrary values, so the encoded strings are compared case-sensitively
+	struct FCaseSensitiveKeyFuncs : BaseKeyFuncs<TPair<FString, TSharedPtr<FJsonValue>>, FString, false>
+	{
+		static const FString& GetSetKey(const TPair<FString, TSharedPtr<FJsonValue>>& Element) { return Element.Key; }
+		static bool Matches(const FString& A, const FString& B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+		static uint32 GetKeyHash(const FString& Key) { return FCrc::StrCrc32(*Key); }
+	};
+
+	struct FTableReader
+	{
+		TArray<FString> Classes;
+		TArray<FString> Packages;
+		// Encoded reference => json value of the reference, so each unique reference is decoded and allocated once
+		// (the fields with the same reference share the value)
+		TMap<FString, TSharedPtr<FJsonValue>, FDefaultSetAllocator, FCaseSensitiveKeyFuncs> DecodedValues;
+		bool bIsValid = true;
+
+		const TSharedPtr<FJsonValue>& DecodeValue(const FString& InValue)
+		{
+			if (const TSharedPtr<FJsonValue>* DecodedValue = DecodedValues.Find(InValue))
+				return *DecodedValue;
+			return DecodedValues.Add(InValue, MakeShared<FJsonValueString>(Decode(InValue)));
+		}
+
+		FString Decode(const FString& InValue)
+		{
+			if (InValue.Len() > 1 && InValue[1] == EncodedPrefix)
+				return InValue.Mid(1);
+
+			// "@<class index>:<package index>.Object:SubObject"
+			const TCHAR* Cur = *InValue + 1;
+			TCHAR* End = nullptr;
+			const int32 ClassIndex = FCString::Strtoi(Cur, &End, 10);
+			if (End == Cur || *End != TEXT(':'))
+				return Invalid(InValue);
+			Cur = End + 1;
+			const int32 PackageIndex = FCString::Strtoi(Cur, &End, 10);
+			if (End == Cur || (*End != TEXT('\0') && *End != TEXT('.')) || !Classes.IsValidIndex(ClassIndex) || !Packages.IsValidIndex(PackageIndex))
+				return Invalid(InValue);
+
+			return Classes[ClassIndex] + TEXT("'") + Packages[PackageIndex] + End + TEXT("'");
+		}
+
+		FString Invalid(const FString& InValue)
+		{
+			UE_LOG(LogDemoJsonCallback, Error, TEXT("Invalid interned reference '%s'."), *InValue);
+			bIsValid = false;
+			return InValue;
+		}
+	};
+
+	TSharedPtr<FJsonValue> ExpandValue(const TSharedPtr<FJsonValue>& Value, FTableReader& Table);
+
+	void ExpandObject(const TSharedPtr<FJsonObject>& JsonObject, FTableReader& Table)
+	{
+		for (TPair<FString, TSharedPtr<FJsonValue>>& Field : JsonObject->Values)
+			Field.Value = ExpandValue(Field.Value, Table);
+	}
+
+	TSharedPtr<FJsonValue> ExpandValue(const TSharedPtr<FJsonValue>& Value, FTableReader& Table)
+	{
+		if (!Value.IsValid())
+			return Value;
+
+		switch (Value->Type)
+		{
+		case EJson::String:
+		{
+			const FString& StringValue = Value->AsString();
+			if (StringValue.Len() == 0 || StringValue[0] != EncodedPrefix)
+				return Value;
+			return Table.DecodeValue(StringValue);
+		}
+		case EJson::Array:
+		{
+			TArray<TSharedPtr<FJsonValue>> Elements;
+			Elements.Reserve(Value->AsArray().Num());
+			for (const TSharedPtr<FJsonValue>& Element : Value->AsArray())
+				Elements.Add(ExpandValue(Element, Table));
+			return MakeShared<FJsonValueArray>(Elements);
+		}
+		case EJson::Object:
+			ExpandObject(Value->AsObject(), Table);
+			return Value;
+		default:
+			return Value;
+		}
+	}
+
+	bool ReadStringArray(const TSharedPtr<FJsonObject>& JsonTable, const FString& FieldName, TArray<FString>& OutValues)
+	{
+		const TArray<TSharedPtr<FJsonValue>>* JsonValues;
+		if (!JsonTable->TryGetArrayField(FieldName, JsonValues))
+			return false;
+
+		OutValues.Reserve(JsonValues->Num());
+		for (const TSharedPtr<FJsonValue>& JsonValue : *JsonValues)
+			OutValues.Add(JsonValue->AsString());
+		return true;
+	}
+}
+
+namespace FJsonReferenceTable
+{
+	void InternReferences(const TSharedRef<FJsonObject>& InOutJsonObject)
+	{
+		using namespace FJsonReferenceTableLocal;
+
+		FTableBuilder Table;
+		InternObject(InOutJsonObject, Table);
+
+		TArray<TSharedPtr<FJsonValue>> JsonClasses;
+		for (const FString& ClassName : Table.Classes)
+			JsonClasses.Add(MakeShared<FJsonValueString>(ClassName));
+		TArray<TSharedPtr<FJsonValue>> JsonPackages;
+		for (const FString& PackageName : Table.Packages)
+			JsonPackages.Add(MakeShared<FJsonValueString>(PackageName));
+
+		TSharedRef<FJsonObject> JsonTable = MakeShared<FJsonObject>();
+		JsonTable->SetArrayField(TEXT("Classes"), JsonClasses);
+		JsonTable->SetArrayField(TEXT("Packages"), JsonPackages);
+
+		// The table goes first, so it can be read before the references
+		TMap<FString, TSharedPtr<FJsonValue>> Values;
+		Values.Reserve(InOutJsonObject->Values.Num() + 1);
+		Values.Add(TableFieldName, MakeShared<FJsonValueObject>(JsonTable));
+		Values.Append(MoveTemp(InOutJsonObject->Values));
+		InOutJsonObject->Values = MoveTemp(Values);
+	}
+
+	bool ExpandReferences(const TSharedRef<FJsonObject>& InOutJsonObject)
+	{
+		using namespace FJsonReferenceTableLocal;
+
+		TSharedPtr<FJsonValue> JsonTableValue;
+		if (!InOutJsonObject->Values.RemoveAndCopyValue(TableFieldName, JsonTableValue))
+			return true;
+
+		FTableReader Table;
+		const TSharedPtr<FJsonObject>* JsonTable;
+		if (!JsonTableValue->TryGetObject(JsonTable)
+			|| !ReadStringArray(*JsonTable, TEXT("Classes"), Table.Classes)
+			|| !ReadStringArray(*JsonTable, TEXT("Packages"), Table.Packages))
+		{
+			UE_LOG(LogDemoJsonCallback, Error, TEXT("Invalid '%s' field."), *TableFieldName);
+			return false;
+		}
+
+		ExpandObject(InOutJsonObject, Table);
+		return Table.bIsValid;
+	}
+}
@@ -0,0 +1,26 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+
+/**
+ * Interned object references of the exported json ("-InternRefs").
+ * Unique class names and package paths are written once into the table field of the root object:
+ *   "$RefTable": { "Classes": ["SomeDataAsset", ...], "Packages": ["/Game/Path/Package", ...] }
+ * and each reference "Class'/Game/Path/Package.Object:SubObject'" becomes "@<class index>:<package index>.Object:SubObject".
+ * Other strings starting with '@' are escaped as "@@...".
+ */
+namespace FJsonReferenceTable
+{
+	static const FString TableFieldName = TEXT("$RefTable");
+
+	// Replace all references in the string values of the object (recursive) and add the table
+	void InternReferences(const TSharedRef<FJsonObject>& InOutJsonObject);
+
+	// Restore the references if the object has the table (otherwise does nothing). Each unique encoded reference
+	// is decoded into one json value shared by its fields. The objects are resolved on import by
+	// FObjectImportReferenceCache. Returns false if the table or a reference is invalid
+	bool ExpandReferences(const TSharedRef<FJsonObject>& InOutJsonObject);
+}
@@ -0,0 +1,509 @@
+#include "JsonRoundTripBenchmarkCommandlet.h"
+
+#include "CustomJsonCallbacks.h"
+#include "JsonConverterStats.h"
+#include "JsonObjectGraph.h"
+#include "JsonPropertyStreamReader.h"
+#include "JsonPropertyStreamWriter.h"
+#include "JsonTypedSerializers.h"
+#include "ObjectExportPathCache.h"
+#include "Dom/JsonObject.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "UE4ContributionCases/SplitFullObjectPathCase/SomeDataAsset.h"
+
+namespace FJsonRoundTripBenchmarkLocal
+{
+	// Heap of the current thread while tracking is enabled on it: allocated minus freed bytes and its maximum
+	struct FThreadHeapCounters
+	{
+		bool bEnabled;
+		int64 LiveBytes;
+		int64 PeakLiveBytes;
+	};
+	static thread_local FThreadHeapCounters ThreadHeapCounters = { false, 0, 0 };
+
+	/**
+	 * Proxy of GMalloc which tracks the heap of the threads with enabled counters (the stages run on the game thread).
+	 * It is installed once and never removed: swapping GMalloc back and forth while other threads allocate is not safe
+	 */
+	class FMallocHeapTrackingProxy : public FMalloc
+	{
+	public:
+		static void Install()
+		{
+			static FMallocHeapTrackingProxy* Instance = nullptr;
+			if (!Instance)
+			{
+				Instance = new FMallocHeapTrackingProxy(GMalloc);
+				GMalloc = Instance;
+			}
+		}
+
+		virtual void* Malloc(SIZE_T Size, uint32 Alignment) override
+		{
+			void* Result = Inner->Malloc(Size, Alignment);
+			if (ThreadHeapCounters.bEnabled)
+				AddBytes(GetSize(Result, Size));
+			return Result;
+		}
+
+		virtual void* Realloc(void* Ptr, SIZE_T NewSize, uint32 Alignment) override
+		{
+			if (!ThreadHeapCounters.bEnabled)
+				return Inner->Realloc(Ptr, NewSize, Alignment);
+
+			const int64 OldSize = Ptr ? GetSize(Ptr, 0) : 0;
+			void* Result = Inner->Realloc(Ptr, NewSize, Alignment);
+			AddBytes((Result ? GetSize(Result, NewSize) : 0) - OldSize);
+			return Result;
+		}
+
+		virtual void Free(void* Ptr) override
+		{
+			if (Ptr && ThreadHeapCounters.bEnabled)
+				AddBytes(-GetSize(Ptr, 0));
+			Inner->Free(Ptr);
+		}
+
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+		virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+		virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+		virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+		virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+		virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+
+	private:
+		explicit FMallocHeapTrackingProxy(FMalloc* InInner)
+			: Inner(InInner)
+		{
+		}
+
+		// Size of the allocation, the requested size if the allocator doesn't know it
+		int64 GetSize(void* Ptr, SIZE_T RequestedSize)
+		{
+			SIZE_T Size = 0;
+			return Inner->GetAllocationSize(Ptr, Size) ? int64(Size) : int64(RequestedSize);
+		}
+
+		static void AddBytes(int64 NumBytes)
+		{
+			FThreadHeapCounters& Counters = ThreadHeapCounters;
+			Counters.LiveBytes += NumBytes;
+			Counters.PeakLiveBytes = FMath::Max(Counters.PeakLiveBytes, Counters.LiveBytes);
+		}
+
+		FMalloc* Inner;
+	};
+
+	struct FStageResult
+	{
+		FString Name;
+		double Seconds = 0.0;
+		int64 NumBytes = 0;
+		// Process memory at the end of the stage
+		uint64 UsedPhysical = 0;
+		// Peak growth of the heap during the stage, above the heap at its start
+		int64 PeakHeapBytes = 0;
+	};
+
+	// Run the stage and measure its time and memory
+	template <typename StageFunctionType>
+	FStageResult RunStage(const FString& InName, StageFunctionType StageFunction)
+	{
+		FStageResult Result;
+		Result.Name = InName;
+
+		// The baseline of each stage is its start
+		FMallocHeapTrackingProxy::Install();
+		ThreadHeapCounters = { true, 0, 0 };
+
+		const double StartSeconds = FPlatformTime::Seconds();
+		Result.NumBytes = StageFunction();
+		Result.Seconds = FPlatformTime::Seconds() - StartSeconds;
+
+		ThreadHeapCounters.bEnabled = false;
+		Result.PeakHeapBytes = ThreadHeapCounters.PeakLiveBytes;
+		Result.UsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+		return Result;
+	}
+
+	// Leaf of the instanced objects chain, or the chain of UNestedTypeForInstancing
+	USomeClassForInstancedProperties* CreateInstancedObject(UObject* Outer, int32 Depth, const FJsonRoundTripBenchmarkSettings& Settings, FRandomStream& Random, int32& NumSubObjects)
+	{
+		++NumSubObjects;
+		if (Depth > 1)
+		{
+			UNestedTypeForInstancing* NestedObject = NewObject<UNestedTypeForInstancing>(Outer);
+			const int32 NumValues = 1 + Random.RandHelper(4);
+			for (int32 Index = 0; Index < NumValues; ++Index)
+				NestedObject->SomeValues.Add(Random.FRandRange(-1000.f, 1000.f));
+			NestedObject->NestedObject = CreateInstancedObject(NestedObject, Depth - 1, Settings, Random, NumSubObjects);
+			return NestedObject;
+		}
+
+		const bool bFirstType = Settings.SubObjectTypes == TEXT("First") || (Settings.SubObjectTypes != TEXT("Second") && Random.RandHelper(2) == 0);
+		if (bFirstType)
+		{
+			UFirstTypeForInstancing* FirstObject = NewObject<UFirstTypeForInstancing>(Outer);
+			FirstObject->SomeString = FString::Printf(TEXT("SomeString_%d"), Random.RandHelper(1000000));
+			return FirstObject;
+		}
+
+		USecondTypeForInstancing* SecondObject = NewObject<USecondTypeForInstancing>(Outer);
+		SecondObject->SomeIntValue = Random.RandRange(-1000000, 1000000);
+		return SecondObject;
+	}
+
+	bool IsInstancedObject(const UObject* Object)
+	{
+		return Object && Object->GetOuter() && !Object->GetOuter()->IsA<UPackage>();
+	}
+
+	void CompareObjects(const UObject* Expected, const UObject* Actual, const FString& Path, TArray<FString>& OutDifferences);
+
+	// Property-level comparison. Instanced objects are compared by class, name and properties, other references by pointer
+	void CompareValues(const FProperty* Property, const void* Expected, const void* Actual, const FString& Path, TArray<FString>& OutDifferences)
+	{
+		if (const FObjectProperty* ObjectProperty = CastField<FObjectProperty>(Property))
+		{
+			const UObject* ExpectedObject = ObjectProperty->GetObjectPropertyValue(Expected);
+			const UObject* ActualObject = ObjectProperty->GetObjectPropertyValue(Actual);
+			if (!IsInstancedObject(ExpectedObject) || !ActualObject)
+			{
+				if (ExpectedObject != ActualObject)
+					OutDifferences.Add(FString::Printf(TEXT("%s: '%s' expected, but '%s' found"), *Path, *GetPathNameSafe(ExpectedObject), *GetPathNameSafe(ActualObject)));
+				return;
+			}
+			if (ExpectedObject->GetClass() != ActualObject->GetClass() || ExpectedObject->GetFName() != ActualObject->GetFName())
+			{
+				OutDifferences.Add(FString::Printf(TEXT("%s: %s %s expected, but %s %s found"), *Path,
+					*ExpectedObject->GetClass()->GetName(), *ExpectedObject->GetName(), *ActualObject->GetClass()->GetName(), *ActualObject->GetName()));
+				return;
+			}
+			CompareObjects(ExpectedObject, ActualObject, Path, OutDifferences);
+			return;
+		}
+
+		if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+		{
+			FScriptArrayHelper ExpectedHelper(ArrayProperty, Expected);
+			FScriptArrayHelper ActualHelper(ArrayProperty, Actual);
+			if (ExpectedHelper.Num() != ActualHelper.Num())
+			{
+				OutDifferences.Add(FString::Printf(TEXT("%s: %d elements expected, but %d found"), *Path, ExpectedHelper.Num(), ActualHelper.Num()));
+				return;
+			}
+			for (int32 Index = 0; Index < ExpectedHelper.Num(); ++Index)
+				CompareValues(ArrayProperty->Inner, ExpectedHelper.GetRawPtr(Index), ActualHelper.GetRawPtr(Index), FString::Printf(TEXT("%s[%d]"), *Path, Index), OutDifferences);
+			return;
+		}
+
+		if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+		{
+			for (TFieldIterator<FProperty> It(StructProperty->Struct); It; ++It)
+			{
+				for (int32 Index = 0; Index < It->ArrayDim; ++Index)
+					CompareValues(*It, It->ContainerPtrToValuePtr<void>(Expected, Index), It->ContainerPtrToValuePtr<void>(Actual, Index), Path + TEXT(".") + It->GetName(), OutDifferences);
+			}
+			return;
+		}
+
+		if (!Property->Identical(Expected, Actual, PPF_None))
+		{
+			FString ExpectedText;
+			FString ActualText;
+			Property->ExportTextItem(ExpectedText, Expected, nullptr, nullptr, PPF_None);
+			Property->ExportTextItem(ActualText, Actual, nullptr, nullptr, PPF_None);
+			OutDifferences.Add(FString::Printf(TEXT("%s: '%s' expected, but '%s' found"), *Path, *ExpectedText, *ActualText));
+		}
+	}
+
+	void CompareObjects(const UObject* Expected, const UObject* Actual, const FString& Path, TArray<FString>& OutDifferences)
+	{
+		for (TFieldIterator<FProperty> It(Expected->GetClass()); It; ++It)
+		{
+			for (int32 Index = 0; Index < It->ArrayDim; ++Index)
+				CompareValues(*It, It->ContainerPtrToValuePtr<void>(Expected, Index), It->ContainerPtrToValuePtr<void>(Actual, Index), Path + TEXT(".") + It->GetName(), OutDifferences);
+		}
+	}
+}
+
+FJsonRoundTripBenchmarkSettings FJsonRoundTripBenchmarkSettings::FromParams(const FString& Params)
+{
+	FJsonRoundTripBenchmarkSettings Settings;
+	FParse::Value(*Params, TEXT("Count="), Settings.NumObjects);
+	FParse::Value(*Params, TEXT("ArrayLength="), Settings.ArrayLength);
+	FParse::Value(*Params, TEXT("SubObjectTypes="), Settings.SubObjectTypes);
+	FParse::Value(*Params, TEXT("Depth="), Settings.Depth);
+	FParse::Value(*Params, TEXT("Seed="), Settings.Seed);
+	Settings.bStreaming = FParse::Param(*Params, TEXT("Streaming"));
+	Settings.bObjectGraph = FParse::Param(*Params, TEXT("ObjectGraph"));
+	Settings.bDelta = FParse::Param(*Params, TEXT("Delta"));
+	Settings.bTypedParity = FParse::Param(*Params, TEXT("TypedParity"));
+	Settings.CsvFilePath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("JsonRoundTripBenchmark.csv"));
+	FParse::Value(*Params, TEXT("Csv="), Settings.CsvFilePath);
+	return Settings;
+}
+
+UJsonRoundTripBenchmarkCommandlet::UJsonRoundTripBenchmarkCommandlet(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	LogToConsole = true;
+}
+
+int32 UJsonRoundTripBenchmarkCommandlet::Main(const FString& Params)
+{
+	using namespace FCustomCallbacksDemoLocal;
+	using namespace FJsonRoundTripBenchmarkLocal;
+
+	const FJsonRoundTripBenchmarkSettings Settings = FJsonRoundTripBenchmarkSettings::FromParams(Params);
+	if (Settings.SubObjectTypes != TEXT("First") && Settings.SubObjectTypes != TEXT("Second") && Settings.SubObjectTypes != TEXT("Mixed"))
+	{
+		UE_LOG(LogJsonRoundTripBenchmark, Error, TEXT("Unknown -SubObjectTypes='%s', expected First, Second or Mixed."), *Settings.SubObjectTypes);
+		return 1;
+	}
+	if (Settings.NumObjects < 0 || Settings.ArrayLength < 0)
+	{
+		UE_LOG(LogJsonRoundTripBenchmark, Error, TEXT("-Count= and -ArrayLength= must not be negative."));
+		return 1;
+	}
+	if (Settings.bStreaming && (Settings.bObjectGraph || Settings.bDelta || Settings.bTypedParity))
+		UE_LOG(LogJsonRoundTripBenchmark, Warning, TEXT("-ObjectGraph, -Delta and -TypedParity are not supported by the streaming export."));
+	const bool bTypedParity = Settings.bTypedParity && !Settings.bStreaming;
+	SetExportDelta(Settings.bDelta && !Settings.bStreaming);
+	FJsonTypedSerializerRegistry::Get().SetEnabled(FParse::Param(*Params, TEXT("TypedSerializers")));
+	FJsonConverterStats::Get().Reset();
+
+	UE_LOG(LogJsonRoundTripBenchmark, Display, TEXT("Round-trip benchmark: %d objects, array length %d, %s sub objects, depth %d, %s."),
+		Settings.NumObjects, Settings.ArrayLength, *Settings.SubObjectTypes, Settings.Depth, Settings.bStreaming ? TEXT("streaming") : TEXT("json tree"));
+
+	// Originals are rooted: they live in the transient package and are referenced only from here
+	TArray<USomeDataAsset*> Originals;
+	TArray<FName> ObjectNames;
+	int32 NumSubObjects = 0;
+	{
+		FRandomStream Random(Settings.Seed);
+		for (int32 Index = 0; Index < Settings.NumObjects; ++Index)
+		{
+			const FName ObjectName = MakeUniqueObjectName(GetTransientPackage(), USomeDataAsset::StaticClass(), TEXT("DA_RoundTrip"));
+			USomeDataAsset* Object = NewObject<USomeDataAsset>(GetTransientPackage(), ObjectName);
+			Object->AddToRoot();
+			Object->ArrayStructWithInstancedObject.SetNum(Settings.ArrayLength);
+			for (FSomeStructWithInstancedProperty& Element : Object->ArrayStructWithInstancedObject)
+				Element.ObjectForInstancing = CreateInstancedObject(Object, FMath::Max(Settings.Depth, 1), Settings, Random, NumSubObjects);
+
+			Originals.Add(Object);
+			ObjectNames.Add(ObjectName);
+		}
+	}
+	UE_LOG(LogJsonRoundTripBenchmark, Display, TEXT("Generated %d objects with %d sub objects."), Originals.Num(), NumSubObjects);
+
+	// Typed serializers are toggled for the parity stages, the main stages use the path of the command line
+	const bool bTypedSerializers = FJsonTypedSerializerRegistry::Get().IsEnabled();
+	const FString OtherPathName = bTypedSerializers ? TEXT("Reflection") : TEXT("Typed");
+
+	// Export into UTF-8 records in memory (as the records of the bulk export)
+	auto ExportRecords = [&](TArray<TArray<uint8>>& Records)
+	{
+		JSON_CONVERTER_TIMER_SCOPE(Export);
+		Records.SetNum(Originals.Num());
+		int64 NumBytes = 0;
+		for (int32 Index = 0; Index < Originals.Num(); ++Index)
+		{
+			const FString& AssetRef = FObjectExportPathCache::Get().GetExportPath(Originals[Index]);
+			if (Settings.bStreaming)
+			{
+				FMemoryWriter MemoryWriter(Records[Index]);
+				FJsonPropertyStreamWriter JsonWriter(&MemoryWriter);
+				JsonWriter.WriteObject(Originals[Index], AssetRef);
+				JsonWriter.Close();
+			}
+			else
+			{
+				const TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+				JsonObject->SetStringField(AssetRefPropertyName, AssetRef);
+				if (Settings.bObjectGraph)
+					FJsonObjectGraph::ExportObject(Originals[Index], JsonObject);
+				else
+					ExportObjectProperties(Originals[Index], JsonObject);
+
+				const FTCHARToUTF8 Utf8Json(*SerializeJsonCondensed(JsonObject));
+				Records[Index].Append(reinterpret_cast<const uint8*>(Utf8Json.Get()), Utf8Json.Length());
+			}
+			NumBytes += Records[Index].Num();
+		}
+		JSON_CONVERTER_COUNT(BytesWritten, NumBytes);
+		return NumBytes;
+	};
+
+	// Stage 1: export
+	TArray<TArray<uint8>> Records;
+	TArray<FStageResult> Results;
+	Results.Add(RunStage(TEXT("Export"), [&]() { return ExportRecords(Records); }));
+
+	// Parity: the other path must write the same records
+	int32 NumDifferentRecords = 0;
+	if (bTypedParity)
+	{
+		TArray<TArray<uint8>> OtherRecords;
+		FJsonTypedSerializerRegistry::Get().SetEnabled(!bTypedSerializers);
+		Results.Add(RunStage(TEXT("Export") + OtherPathName, [&]() { return ExportRecords(OtherRecords); }));
+		FJsonTypedSerializerRegistry::Get().SetEnabled(bTypedSerializers);
+
+		for (int32 Index = 0; Index < Records.Num(); ++Index)
+		{
+			if (Records[Index] == OtherRecords[Index])
+				continue;
+			if (NumDifferentRecords++ < 10)
+				UE_LOG(LogJsonRoundTripBenchmark, Warning, TEXT("Record of '%s' differs between the typed and the reflection export."), *Originals[Index]->GetName());
+		}
+	}
+
+	// The objects with the names are moved aside (with their sub objects), the records are imported into empty objects
+	// with the same names, so the references inside the records resolve to the new objects
+	const uint32 RenameFlags = REN_DontCreateRedirectors | REN_DoNotDirty | REN_NonTransactional | REN_ForceNoResetLoaders;
+	auto CreateImportTargets = [&](TArray<USomeDataAsset*>& OutImported)
+	{
+		for (int32 Index = 0; Index < ObjectNames.Num(); ++Index)
+		{
+			USomeDataAsset* Object = NewObject<USomeDataAsset>(GetTransientPackage(), ObjectNames[Index]);
+			Object->AddToRoot();
+			OutImported.Add(Object);
+		}
+		FObjectExportPathCache::Get().Empty();
+	};
+	for (int32 Index = 0; Index < Originals.Num(); ++Index)
+		Originals[Index]->Rename(*(ObjectNames[Index].ToString() + TEXT("_Original")), nullptr, RenameFlags);
+	TArray<USomeDataAsset*> Imported;
+	CreateImportTargets(Imported);
+
+	// Import from the records
+	int32 NumFailed = 0;
+	auto ImportRecords = [&](const TArray<USomeDataAsset*>& Targets)
+	{
+		JSON_CONVERTER_TIMER_SCOPE(Import);
+		int64 NumBytes = 0;
+		for (int32 Index = 0; Index < Targets.Num(); ++Index)
+		{
+			NumBytes += Records[Index].Num();
+			JSON_CONVERTER_COUNT(BytesRead, Records[Index].Num());
+			if (Settings.bStreaming)
+			{
+				FMemoryReader MemoryReader(Records[Index]);
+				FJsonPropertyStreamReader JsonReader(&MemoryReader);
+				if (!JsonReader.ReadObject(Targets[Index]))
+				{
+					UE_LOG(LogJsonRoundTripBenchmark, Error, TEXT("Unable to import record of '%s': %s"), *Targets[Index]->GetName(), *JsonReader.GetErrorMessage());
+					++NumFailed;
+				}
+				continue;
+			}
+
+			const FUTF8ToTCHAR JsonText(reinterpret_cast<const ANSICHAR*>(Records[Index].GetData()), Records[Index].Num());
+			TSharedPtr<FJsonObject> JsonObject;
+			if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(FString(JsonText.Length(), JsonText.Get())), JsonObject) || !JsonObject.IsValid()
+				|| !ImportObjectProperties(Targets[Index], JsonObject.ToSharedRef()))
+			{
+				UE_LOG(LogJsonRoundTripBenchmark, Error, TEXT("Unable to import record of '%s'."), *Targets[Index]->GetName());
+				++NumFailed;
+			}
+		}
+		return NumBytes;
+	};
+
+	// Property-level comparison, the number of different objects
+	auto VerifyObjects = [&](const TArray<USomeDataAsset*>& Expected, const TArray<USomeDataAsset*>& Actual)
+	{
+		int32 NumDifferent = 0;
+		for (int32 Index = 0; Index < Actual.Num(); ++Index)
+		{
+			TArray<FString> Differences;
+			CompareObjects(Expected[Index], Actual[Index], Actual[Index]->GetName(), Differences);
+			if (Differences.Num() == 0)
+				continue;
+
+			// Only the first objects are logged in details, the differences are usually the same for all of them
+			if (NumDifferent++ < 10)
+			{
+				for (const FString& Difference : Differences)
+					UE_LOG(LogJsonRoundTripBenchmark, Warning, TEXT("%s"), *Difference);
+			}
+		}
+		return NumDifferent;
+	};
+
+	// Stage 2: import
+	Results.Add(RunStage(TEXT("Import"), [&]() { return ImportRecords(Imported); }));
+
+	// Stage 3: comparison with the originals
+	int32 NumDifferentObjects = 0;
+	Results.Add(RunStage(TEXT("Verify"), [&]()
+	{
+		NumDifferentObjects = VerifyObjects(Originals, Imported);
+		return int64(0);
+	}));
+
+	// Parity: the other path imports the same records into the same objects
+	TArray<USomeDataAsset*> OtherImported;
+	int32 NumParityDifferences = 0;
+	if (bTypedParity)
+	{
+		for (int32 Index = 0; Index < Imported.Num(); ++Index)
+			Imported[Index]->Rename(*(ObjectNames[Index].ToString() + TEXT("_Imported")), nullptr, RenameFlags);
+		CreateImportTargets(OtherImported);
+
+		FJsonTypedSerializerRegistry::Get().SetEnabled(!bTypedSerializers);
+		Results.Add(RunStage(TEXT("Import") + OtherPathName, [&]() { return ImportRecords(OtherImported); }));
+		FJsonTypedSerializerRegistry::Get().SetEnabled(bTypedSerializers);
+
+		const int32 NumDifferentImports = VerifyObjects(Imported, OtherImported);
+		UE_LOG(LogJsonRoundTripBenchmark, Display, TEXT("Typed parity: %d of %d records and %d of %d imported objects differ between the typed and the reflection path."),
+			NumDifferentRecords, Records.Num(), NumDifferentImports, OtherImported.Num());
+		NumParityDifferences = NumDifferentRecords + NumDifferentImports;
+	}
+
+	for (int32 Index = 0; Index < Originals.Num(); ++Index)
+	{
+		Originals[Index]->RemoveFromRoot();
+		Imported[Index]->RemoveFromRoot();
+	}
+	for (USomeDataAsset* Object : OtherImported)
+		Object->RemoveFromRoot();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	// Report
+	const FString EngineVersion = FEngineVersion::Current().ToString();
+	FString Csv;
+	if (!FPaths::FileExists(Settings.CsvFilePath))
+		Csv += TEXT("EngineVersion,Stage,Count,ArrayLength,SubObjectTypes,Depth,Streaming,ObjectGraph,Delta,TypedSerializers,Seconds,ObjectsPerSecond,MBPerSecond,UsedMB,StagePeakMB,DifferentObjects\n");
+
+	UE_LOG(LogJsonRoundTripBenchmark, Display, TEXT("%-16s %10s %12s %10s %10s %14s"), TEXT("Stage"), TEXT("ms"), TEXT("objects/s"), TEXT("MB/s"), TEXT("used MB"), TEXT("stage peak MB"));
+	for (const FStageResult& Result : Results)
+	{
+		const double ObjectsPerSecond = Result.Seconds > 0.0 ? Originals.Num() / Result.Seconds : 0.0;
+		const double MBPerSecond = Result.Seconds > 0.0 ? Result.NumBytes / (1024.0 * 1024.0) / Result.Seconds : 0.0;
+		const double UsedMB = Result.UsedPhysical / (1024.0 * 1024.0);
+		const double PeakMB = Result.PeakHeapBytes / (1024.0 * 1024.0);
+		const bool bStageTypedSerializers = Result.Name.EndsWith(OtherPathName) ? !bTypedSerializers : bTypedSerializers;
+		UE_LOG(LogJsonRoundTripBenchmark, Display, TEXT("%-16s %10.2f %12.1f %10.2f %10.1f %14.1f"), *Result.Name, Result.Seconds * 1000.0, ObjectsPerSecond, MBPerSecond, UsedMB, PeakMB);
+		Csv += FString::Printf(TEXT("%s,%s,%d,%d,%s,%d,%d,%d,%d,%d,%.4f,%.1f,%.3f,%.1f,%.1f,%d\n"), *EngineVersion, *Result.Name, Settings.NumObjects, Settings.ArrayLength,
+			*Settings.SubObjectTypes, Settings.Depth, Settings.bStreaming ? 1 : 0, Settings.bObjectGraph && !Settings.bStreaming ? 1 : 0, IsExportDelta() ? 1 : 0, bStageTypedSerializers ? 1 : 0, Result.Seconds, ObjectsPerSecond, MBPerSecond, UsedMB, PeakMB, NumDifferentObjects);
+	}
+	FJsonConverterStats::Get().PrintSummary();
+
+	if (NumDifferentObjects > 0)
+		UE_LOG(LogJsonRoundTripBenchmark, Error, TEXT("%d of %d objects differ from the originals after the round trip."), NumDifferentObjects, Originals.Num());
+
+	if (!FFileHelper::SaveStringToFile(Csv, *Settings.CsvFilePath, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append))
+	{
+		UE_LOG(LogJsonRoundTripBenchmark, Error, TEXT("Unable to save file '%s'."), *Settings.CsvFilePath);
+		return 1;
+	}
+	UE_LOG(LogJsonRoundTripBenchmark, Display, TEXT("Benchmark results appended to '%s'."), *Settings.CsvFilePath);
+
+	return NumFailed == 0 && NumDifferentObjects == 0 && NumParityDifferences == 0 ? 0 : 1;
+}
@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "JsonRoundTripBenchmarkCommandlet.generated.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogJsonRoundTripBenchmark, Log, All);
+
+// Settings of UJsonRoundTripBenchmarkCommandlet
+struct FJsonRoundTripBenchmarkSettings
+{
+	// Number of generated USomeDataAsset objects ("-Count=")
+	int32 NumObjects = 1000;
+	// Length of ArrayStructWithInstancedObject of each object ("-ArrayLength=")
+	int32 ArrayLength = 8;
+	// Types of the instanced objects: "First", "Second" or "Mixed" ("-SubObjectTypes=")
+	FString SubObjectTypes = TEXT("Mixed");
+	// Depth of the instanced objects chain, > 1 - chain of UNestedTypeForInstancing ("-Depth=")
+	int32 Depth = 1;
+	// Seed of the generator ("-Seed="), the same seed gives the same objects
+	int32 Seed = 7371;
+	// FJsonPropertyStreamWriter/FJsonPropertyStreamReader instead of FJsonObject tree ("-Streaming")
+	bool bStreaming = false;
+	// Instanced objects are exported once each into the object table (FJsonObjectGraph), json tree only ("-ObjectGraph")
+	bool bObjectGraph = false;
+	// Only the properties different from the archetype are exported, json tree only ("-Delta")
+	bool bDelta = false;
+	// The export and the import are repeated with the typed serializers toggled, the records and the imported objects
+	// of both paths must be the same, json tree only ("-TypedParity")
+	bool bTypedParity = false;
+	// Results are appended to this CSV file ("-Csv=")
+	FString CsvFilePath;
+
+	static FJsonRoundTripBenchmarkSettings FromParams(const FString& Params);
+};
+
+/**
+ * Export -> import round trip of synthetic objects in the transient package: throughput (objects/s, MB/s)
+ * and memory of each stage (process memory at its end and the peak heap growth during the stage), and property-level comparison of the imported objects with the originals.
+ * With "-TypedParity" the typed serializers and the reflection path are timed and compared on the same objects.
+ * Nothing is loaded from or saved to disk, so the numbers are the cost of the conversion itself.
+ */
+UCLASS()
+class UE4CONTRIBUTIONCASESEDITOR_API UJsonRoundTripBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UJsonRoundTripBenchmarkCommandlet(const FObjectInitializer& ObjectInitializer);
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,249 @@
+#include "JsonTypedSerializers.h"
+
+#include "CustomImportCallbackCommandlet.h"
+#include "CustomJsonCallbacks.h"
+#include "UE4ContributionCases/SplitFullObjectPathCase/SomeDataAsset.h"
+
+namespace FJsonTypedSerializersLocal
+{
+	uint32 HashField(const FString& Name, const FString& CPPType, int32 Offset)
+	{
+		return HashCombine(HashCombine(GetTypeHash(Name), GetTypeHash(CPPType)), GetTypeHash(Offset));
+	}
+
+	// Own fields of the type as seen by the reflection
+	uint32 HashReflectedFields(const UStruct* Struct)
+	{
+		uint32 Hash = 0;
+		for (TFieldIterator<FProperty> Prop(Struct, EFieldIteratorFlags::ExcludeSuper); Prop; ++Prop)
+		{
+			FString ExtendedType;
+			const FString CPPType = Prop->GetCPPType(&ExtendedType, 0);
+			Hash = HashCombine(Hash, HashField(Prop->GetName(), CPPType + ExtendedType, Prop->GetOffset_ForInternal()));
+		}
+		return Hash;
+	}
+
+	uint32 HashTypedFields(const TArray<FJsonTypedField>& Fields)
+	{
+		uint32 Hash = 0;
+		for (const FJsonTypedField& Field : Fields)
+			Hash = HashCombine(Hash, HashField(Field.Name, Field.CPPType, Field.Offset));
+		return Hash;
+	}
+}
+
+template <>
+struct TJsonTypedSerializer<USecondTypeForInstancing>
+{
+	static const UStruct* GetStruct() { return USecondTypeForInstancing::StaticClass(); }
+
+	static void GetFields(TArray<FJsonTypedField>& OutFields)
+	{
+		OutFields.Add({TEXT("SomeIntValue"), TEXT("int32"), STRUCT_OFFSET(USecondTypeForInstancing, SomeIntValue)});
+	}
+
+	static void GetDependencies(TArray<const UStruct*>& OutDependencies) {}
+
+	static void ExportFields(const USecondTypeForInstancing& Data, FJsonObject& OutJsonObject)
+	{
+		OutJsonObject.SetNumberField(TEXT("SomeIntValue"), Data.SomeIntValue);
+	}
+
+	// As FJsonObjectConverter converts integers: numeric string is parsed as int64, number is truncated
+	static EJsonTypedImportResult ImportField(const FString& InFieldName, const TSharedPtr<FJsonValue>& InJsonValue, USecondTypeForInstancing& Data)
+	{
+		if (InFieldName != TEXT("SomeIntValue"))
+			return EJsonTypedImportResult::NotOwnField;
+
+		double Number = 0.0;
+		if (InJsonValue->Type == EJson::String)
+		{
+			Data.SomeIntValue = static_cast<int32>(FCString::Atoi64(*InJsonValue->AsString()));
+		}
+		else if (InJsonValue->TryGetNumber(Number))
+		{
+			Data.SomeIntValue = static_cast<int32>(static_cast<int64>(Number));
+		}
+		else
+		{
+			UE_LOG(LogDemoJsonCallback, Error, TEXT("Number expected for field '%s'."), *InFieldName);
+			return EJsonTypedImportResult::Failed;
+		}
+		return EJsonTypedImportResult::Imported;
+	}
+};
+
+template <>
+struct TJsonTypedSerializer<FSomeStructWithInstancedProperty>
+{
+	static const UStruct* GetStruct() { return FSomeStructWithInstancedProperty::StaticStruct(); }
+
+	static void GetFields(TArray<FJsonTypedField>& OutFields)
+	{
+		OutFields.Add({TEXT("ObjectForInstancing"), TEXT("USomeClassForInstancedProperties*"), STRUCT_OFFSET(FSomeStructWithInstancedProperty, ObjectForInstancing)});
+	}
+
+	// Instanced object is exported by its own class (typed or reflection)
+	static void GetDependencies(TArray<const UStruct*>& OutDependencies) {}
+
+	// Struct fields are named by FJsonObjectConverter::StandardizeCase
+	static void ExportFields(const FSomeStructWithInstancedProperty& Data, FJsonObject& OutJsonObject)
+	{
+		OutJsonObject.SetField(TEXT("objectForInstancing"), FCustomCallbacksDemoLocal::ObjectToJsonValue(Data.ObjectForInstancing));
+	}
+
+	// The instanced object is restored by the same function as on the reflection path (ImportPropertyValue)
+	static EJsonTypedImportResult ImportField(const FString& InFieldName, const TSharedPtr<FJsonValue>& InJsonValue, FSomeStructWithInstancedProperty& Data)
+	{
+		// Field names are compared case-insensitive, as FJsonObjectConverter does
+		if (InFieldName != TEXT("ObjectForInstancing"))
+			return EJsonTypedImportResult::NotOwnField;
+
+		UObject* Object = Data.ObjectForInstancing;
+		const bool bImported = FCustomCallbacksDemoLocal::JsonValueToObjectOfClass(InJsonValue, USomeClassForInstancedProperties::StaticClass(), Object);
+		Data.ObjectForInstancing = static_cast<USomeClassForInstancedProperties*>(Object);
+		if (!bImported)
+		{
+			UE_LOG(LogDemoJsonCallback, Error, TEXT("Unable to import field '%s'."), *InFieldName);
+			return EJsonTypedImportResult::Failed;
+		}
+		return EJsonTypedImportResult::Imported;
+	}
+};
+
+template <>
+struct TJsonTypedSerializer<USomeDataAsset>
+{
+	static const UStruct* GetStruct() { return USomeDataAsset::StaticClass(); }
+
+	static void GetFields(TArray<FJsonTypedField>& OutFields)
+	{
+		OutFields.Add({TEXT("ArrayStructWithInstancedObject"), TEXT("TArray<FSomeStructWithInstancedProperty>"), STRUCT_OFFSET(USomeDataAsset, ArrayStructWithInstancedObject)});
+	}
+
+	static void GetDependencies(TArray<const UStruct*>& OutDependencies)
+	{
+		OutDependencies.Add(FSomeStructWithInstancedProperty::StaticStruct());
+	}
+
+	static void ExportFields(const USomeDataAsset& Data, FJsonObject& OutJsonObject)
+	{
+		TArray<TSharedPtr<FJsonValue>> JsonElements;
+		JsonElements.Reserve(Data.ArrayStructWithInstancedObject.Num());
+		for (const FSomeStructWithInstancedProperty& Element : Data.ArrayStructWithInstancedObject)
+		{
+			TSharedRef<FJsonObject> JsonElement = MakeShared<FJsonObject>();
+			TJsonTypedSerializer<FSomeStructWithInstancedProperty>::ExportFields(Element, *JsonElement);
+			JsonElements.Add(MakeShared<FJsonValueObject>(JsonElement));
+		}
+		OutJsonObject.SetArrayField(TEXT("ArrayStructWithInstancedObject"), JsonElements);
+	}
+
+	static EJsonTypedImportResult ImportField(const FString& InFieldName, const TSharedPtr<FJsonValue>& InJsonValue, USomeDataAsset& Data)
+	{
+		if (InFieldName != TEXT("ArrayStructWithInstancedObject"))
+			return EJsonTypedImportResult::NotOwnField;
+
+		const TArray<TSharedPtr<FJsonValue>>* JsonElements;
+		if (!InJsonValue->TryGetArray(JsonElements))
+		{
+			UE_LOG(LogDemoJsonCallback, Error, TEXT("Array expected for field '%s'."), *InFieldName);
+			return EJsonTypedImportResult::Failed;
+		}
+
+		// The other elements are imported after a failed one, as on the reflection path
+		EJsonTypedImportResult Result = EJsonTypedImportResult::Imported;
+		Data.ArrayStructWithInstancedObject.SetNum(JsonElements->Num());
+		for (int32 Index = 0; Index < JsonElements->Num(); ++Index)
+		{
+			const TSharedPtr<FJsonObject>* JsonElement;
+			if (!(*JsonElements)[Index]->TryGetObject(JsonElement))
+			{
+				UE_LOG(LogDemoJsonCallback, Error, TEXT("Object expected for element %d of field '%s'."), Index, *InFieldName);
+				Result = EJsonTypedImportResult::Failed;
+				continue;
+			}
+
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& JsonField : (*JsonElement)->Values)
+			{
+				const EJsonTypedImportResult FieldResult = TJsonTypedSerializer<FSomeStructWithInstancedProperty>::ImportField(JsonField.Key, JsonField.Value, Data.ArrayStructWithInstancedObject[Index]);
+				if (FieldResult == EJsonTypedImportResult::NotOwnField)
+					UE_LOG(LogDemoJsonCallback, Error, TEXT("Property '%s' not found in %s."), *JsonField.Key, *FSomeStructWithInstancedProperty::StaticStruct()->GetName());
+				if (FieldResult != EJsonTypedImportResult::Imported)
+					Result = EJsonTypedImportResult::Failed;
+			}
+		}
+		return Result;
+	}
+};
+
+FJsonTypedSerializerRegistry& FJsonTypedSerializerRegistry::Get()
+{
+	static FJsonTypedSerializerRegistry Instance;
+	return Instance;
+}
+
+FJsonTypedSerializerRegistry::FJsonTypedSerializerRegistry()
+{
+	// Types which make up most of the data volume
+	Register<USomeDataAsset>();
+	Register<FSomeStructWithInstancedProperty>();
+	Register<USecondTypeForInstancing>();
+
+	// Offsets and types may change on hot-reload
+	FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([this](EReloadCompleteReason)
+	{
+		if (bEnabled)
+			VerifySerializers();
+	});
+}
+
+void FJsonTypedSerializerRegistry::SetEnabled(bool bInEnabled)
+{
+	bEnabled = bInEnabled;
+	if (bEnabled)
+		VerifySerializers();
+}
+
+void FJsonTypedSerializerRegistry::VerifySerializers()
+{
+	using namespace FJsonTypedSerializersLocal;
+
+	VerifiedSerializers.Reset();
+	for (const TUniquePtr<FJsonTypedSerializer>& Serializer : Serializers)
+	{
+		TArray<FJsonTypedField> Fields;
+		Serializer->GetFields(Fields);
+
+		const UStruct* Struct = Serializer->GetStruct();
+		if (HashTypedFields(Fields) != HashReflectedFields(Struct))
+		{
+			UE_LOG(LogDemoJsonCallback, Warning, TEXT("Typed serializer of %s doesn't match the reflection data, reflection is used instead."), *Struct->GetName());
+			continue;
+		}
+		VerifiedSerializers.Add(Struct, Serializer.Get());
+	}
+
+	// Serializer which writes the disabled types inside is disabled as well
+	bool bRemoved = true;
+	while (bRemoved)
+	{
+		bRemoved = false;
+		for (auto It = VerifiedSerializers.CreateIterator(); It; ++It)
+		{
+			TArray<const UStruct*> Dependencies;
+			It.Value()->GetDependencies(Dependencies);
+			for (const UStruct* Dependency : Dependencies)
+			{
+				if (!VerifiedSerializers.Contains(Dependency))
+				{
+					UE_LOG(LogDemoJsonCallback, Warning, TEXT("Typed serializer of %s is disabled with the serializer of %s."), *It.Key()->GetName(), *Dependency->GetName());
+					It.RemoveCurrent();
+					bRemoved = true;
+					break;
+				}
+			}
+		}
+	}
+}
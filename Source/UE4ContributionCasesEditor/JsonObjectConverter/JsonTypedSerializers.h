@@ -0,0 +1,113 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+
+// Field written by a typed serializer. The list is compared with the reflection data before the serializer is used
+struct FJsonTypedField
+{
+	const TCHAR* Name;
+	// As FProperty::GetCPPType with the extended type ("TArray<FSomeStruct>", "UObject*", "int32")
+	const TCHAR* CPPType;
+	int32 Offset;
+};
+
+// Result of FJsonTypedSerializer::ImportField
+enum class EJsonTypedImportResult : uint8
+{
+	// Not an own field of the type, it is imported by reflection
+	NotOwnField,
+	Imported,
+	// The value doesn't match the field (the error is logged), the record is not fully imported
+	Failed
+};
+
+/**
+ * Serializer of the own (not inherited) fields of one UClass/UStruct, which reads and writes the fields directly,
+ * without reflection. The json and the imported values are the same as of ExportObjectProperties/ImportObjectProperties.
+ * The export still builds the same FJsonValue tree: only the per-property reflection dispatch is saved.
+ */
+class FJsonTypedSerializer
+{
+public:
+	virtual ~FJsonTypedSerializer() = default;
+
+	virtual const UStruct* GetStruct() const = 0;
+	virtual void GetFields(TArray<FJsonTypedField>& OutFields) const = 0;
+	// Types written by their typed serializers inside (the serializer is disabled if any of them is)
+	virtual void GetDependencies(TArray<const UStruct*>& OutDependencies) const = 0;
+
+	virtual void ExportFields(const void* Data, FJsonObject& OutJsonObject) const = 0;
+	virtual EJsonTypedImportResult ImportField(const FString& InFieldName, const TSharedPtr<FJsonValue>& InJsonValue, void* Data) const = 0;
+};
+
+/**
+ * Opt-in of a type into the typed serialization: specialize TJsonTypedSerializer<T> with static functions
+ *   const UStruct* GetStruct();
+ *   void GetFields(TArray<FJsonTypedField>& OutFields);
+ *   void GetDependencies(TArray<const UStruct*>& OutDependencies);
+ *   void ExportFields(const T& Data, FJsonObject& OutJsonObject);
+ *   EJsonTypedImportResult ImportField(const FString& InFieldName, const TSharedPtr<FJsonValue>& InJsonValue, T& Data);
+ * and register it in FJsonTypedSerializerRegistry constructor.
+ */
+template <typename T>
+struct TJsonTypedSerializer;
+
+template <typename T>
+class TJsonTypedSerializerAdapter final : public FJsonTypedSerializer
+{
+public:
+	virtual const UStruct* GetStruct() const override { return TJsonTypedSerializer<T>::GetStruct(); }
+	virtual void GetFields(TArray<FJsonTypedField>& OutFields) const override { TJsonTypedSerializer<T>::GetFields(OutFields); }
+	virtual void GetDependencies(TArray<const UStruct*>& OutDependencies) const override { TJsonTypedSerializer<T>::GetDependencies(OutDependencies); }
+
+	virtual void ExportFields(const void* Data, FJsonObject& OutJsonObject) const override
+	{
+		TJsonTypedSerializer<T>::ExportFields(*static_cast<const T*>(Data), OutJsonObject);
+	}
+
+	virtual EJsonTypedImportResult ImportField(const FString& InFieldName, const TSharedPtr<FJsonValue>& InJsonValue, void* Data) const override
+	{
+		return TJsonTypedSerializer<T>::ImportField(InFieldName, InJsonValue, *static_cast<T*>(Data));
+	}
+};
+
+/**
+ * Registered typed serializers ("-TypedSerializers"). A serializer is used only if the hash of its field list
+ * (names, types, offsets) matches the reflection data, otherwise the type falls back to the reflection path.
+ * The check is done on the game thread when the registry is enabled and after hot-reload.
+ */
+class FJsonTypedSerializerRegistry
+{
+public:
+	static FJsonTypedSerializerRegistry& Get();
+
+	void SetEnabled(bool bInEnabled);
+	bool IsEnabled() const { return bEnabled; }
+
+	// Serializer of exactly this class/struct (not of subclasses). nullptr if it is not registered, disabled or outdated
+	const FJsonTypedSerializer* Find(const UStruct* Struct) const
+	{
+		if (!bEnabled)
+			return nullptr;
+		const FJsonTypedSerializer* const* Serializer = VerifiedSerializers.Find(Struct);
+		return Serializer ? *Serializer : nullptr;
+	}
+
+private:
+	FJsonTypedSerializerRegistry();
+
+	template <typename T>
+	void Register()
+	{
+		Serializers.Add(MakeUnique<TJsonTypedSerializerAdapter<T>>());
+	}
+
+	void VerifySerializers();
+
+	bool bEnabled = false;
+	TArray<TUniquePtr<FJsonTypedSerializer>> Serializers;
+	TMap<const UStruct*, const FJsonTypedSerializer*> VerifiedSerializers;
+};
@@ -0,0 +1,40 @@
+#include "ObjectExportPathCache.h"
+
+FObjectExportPathCache& FObjectExportPathCache::Get()
+{
+	static FObjectExportPathCache Instance;
+	return Instance;
+}
+
+FObjectExportPathCache::FObjectExportPathCache()
+{
+	FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FObjectExportPathCache::Empty);
+}
+
+const FString& FObjectExportPathCache::GetExportPath(const UObject* Object)
+{
+	static const FString NoneString(TEXT("None"));
+	if (Object == nullptr)
+		return NoneString;
+
+	const FObjectKey ObjectKey(Object);
+	{
+		FReadScopeLock ReadLock(ExportPathsLock);
+		if (const TUniquePtr<FString>* ExportPath = ExportPaths.Find(ObjectKey))
+			return **ExportPath;
+	}
+
+	TUniquePtr<FString> NewExportPath = MakeUnique<FString>(FString::Printf(TEXT("%s'%s'"), *Object->GetClass()->GetName(), *Object->GetPathName()));
+
+	FWriteScopeLock WriteLock(ExportPathsLock);
+	TUniquePtr<FString>& ExportPath = ExportPaths.FindOrAdd(ObjectKey);
+	if (!ExportPath)
+		ExportPath = MoveTemp(NewExportPath);
+	return *ExportPath;
+}
+
+void FObjectExportPathCache::Empty()
+{
+	FWriteScopeLock WriteLock(ExportPathsLock);
+	ExportPaths.Empty();
+}
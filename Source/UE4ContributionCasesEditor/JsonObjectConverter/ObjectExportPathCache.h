@@ -0,0 +1,29 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+/**
+ * Memo cache of textual references "Class'/Package.Object:SubObject'" of objects.
+ * The same references repeat thousands of times in the exported data, so each one is formatted only once.
+ * Thread-safe (bulk export uses it from worker threads), the cache is emptied after garbage collection.
+ */
+class FObjectExportPathCache
+{
+public:
+	static FObjectExportPathCache& Get();
+
+	// The same text as FObjectProperty::ExportTextItem (PPF_None) gives for the object, "None" for nullptr
+	const FString& GetExportPath(const UObject* Object);
+
+	void Empty();
+
+private:
+	FObjectExportPathCache();
+
+	FRWLock ExportPathsLock;
+	// Values are allocated separately, so the returned references stay valid while the map grows
+	TMap<FObjectKey, TUniquePtr<FString>> ExportPaths;
+};
@@ -0,0 +1,94 @@
+#include "ObjectImportReferenceCache.h"
+
+#include "Dom/JsonValue.h"
+#include "UObject/ConstructorHelpers.h"
+
+namespace FObjectImportReferenceCacheLocal
+{
+	// Hard reference to the object of the other package: instanced objects and classes are imported by the reflection
+	const FObjectProperty* GetReferenceProperty(const FProperty* Property)
+	{
+		const FObjectProperty* ObjectProperty = CastField<FObjectProperty>(Property);
+		if (!ObjectProperty || CastField<FClassProperty>(Property) || Property->HasAnyPropertyFlags(CPF_InstancedReference))
+			return nullptr;
+		return ObjectProperty;
+	}
+}
+
+FObjectImportReferenceCache& FObjectImportReferenceCache::Get()
+{
+	static FObjectImportReferenceCache Instance;
+	return Instance;
+}
+
+FObjectImportReferenceCache::FObjectImportReferenceCache()
+{
+	FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FObjectImportReferenceCache::Empty);
+}
+
+UObject* FObjectImportReferenceCache::Resolve(const FString& InReference)
+{
+	check(IsInGameThread());
+	if (UObject** Object = Objects.Find(InReference))
+		return *Object;
+
+	FString ObjectPath = InReference;
+	ConstructorHelpers::StripObjectClass(ObjectPath);
+	UObject* Object = LoadObject<UObject>(nullptr, *ObjectPath, nullptr, LOAD_NoWarn);
+	Objects.Add(InReference, Object);
+	return Object;
+}
+
+bool FObjectImportReferenceCache::ImportObjectReferences(const FProperty* Property, const TSharedPtr<FJsonValue>& JsonValue, void* OutValue)
+{
+	using namespace FObjectImportReferenceCacheLocal;
+
+	// Resolved object of the json string, false if it can't be assigned to the property
+	auto ResolveValue = [this](const FObjectProperty* ObjectProperty, const TSharedPtr<FJsonValue>& InJsonValue, UObject*& OutObject)
+	{
+		FString Reference;
+		if (!InJsonValue.IsValid() || !InJsonValue->TryGetString(Reference))
+			return false;
+
+		OutObject = Reference == TEXT("None") ? nullptr : Resolve(Reference);
+		return Reference == TEXT("None") || (OutObject && OutObject->IsA(ObjectProperty->PropertyClass));
+	};
+
+	if (Property->ArrayDim != 1)
+		return false;
+
+	if (const FObjectProperty* ObjectProperty = GetReferenceProperty(Property))
+	{
+		UObject* Object = nullptr;
+		if (!ResolveValue(ObjectProperty, JsonValue, Object))
+			return false;
+		ObjectProperty->SetObjectPropertyValue(OutValue, Object);
+		return true;
+	}
+
+	const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property);
+	const FObjectProperty* InnerProperty = ArrayProperty ? GetReferenceProperty(ArrayProperty->Inner) : nullptr;
+	const TArray<TSharedPtr<FJsonValue>>* JsonElements;
+	if (!InnerProperty || !JsonValue.IsValid() || !JsonValue->TryGetArray(JsonElements))
+		return false;
+
+	// All elements are resolved before the array is changed
+	TArray<UObject*> Elements;
+	Elements.SetNumUninitialized(JsonElements->Num());
+	for (int32 Index = 0; Index < JsonElements->Num(); ++Index)
+	{
+		if (!ResolveValue(InnerProperty, (*JsonElements)[Index], Elements[Index]))
+			return false;
+	}
+
+	FScriptArrayHelper ArrayHelper(ArrayProperty, OutValue);
+	ArrayHelper.Resize(Elements.Num());
+	for (int32 Index = 0; Index < Elements.Num(); ++Index)
+		InnerProperty->SetObjectPropertyValue(ArrayHelper.GetRawPtr(Index), Elements[Index]);
+	return true;
+}
+
+void FObjectImportReferenceCache::Empty()
+{
+	Objects.Empty();
+}
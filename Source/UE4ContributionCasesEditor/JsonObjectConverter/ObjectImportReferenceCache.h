@@ -0,0 +1,33 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Memo cache of the objects of textual references "Class'/Package.Object:SubObject'" on import.
+ * The same references repeat thousands of times in the imported data (interned references are restored
+ * to the same strings), so each one is split and found (or loaded) only once.
+ * Game thread only (objects may be loaded), the cache is emptied after garbage collection.
+ */
+class FObjectImportReferenceCache
+{
+public:
+	static FObjectImportReferenceCache& Get();
+
+	// Object of the reference, nullptr if it is not found. "None" is resolved by the caller
+	UObject* Resolve(const FString& InReference);
+
+	// Assign the object reference property (or array of them) from the json string(s) through the cache.
+	// Returns false if the value is not such a reference or is not resolved to the object of the property class:
+	// then the value is left for FJsonObjectConverter, so the result and the errors stay the same
+	bool ImportObjectReferences(const FProperty* Property, const TSharedPtr<FJsonValue>& JsonValue, void* OutValue);
+
+	void Empty();
+
+private:
+	FObjectImportReferenceCache();
+
+	// Missing objects are kept as nullptr as well, so the failed loads are not repeated
+	TMap<FString, UObject*> Objects;
+};
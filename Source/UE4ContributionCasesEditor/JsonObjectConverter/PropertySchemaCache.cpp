@@ -0,0 +1,146 @@
+#include "PropertySchemaCache.h"
+
+#include "CustomJsonCallbacks.h"
+#include "Modules/ModuleManager.h"
+
+namespace FPropertySchemaCacheLocal
+{
+	// Whether the value of the property can contain object references (so it needs ObjectJsonCallback)
+	bool ContainsObjectReference(const FProperty* Property, TSet<const UStruct*>& EncounteredStructs)
+	{
+		if (CastField<FObjectPropertyBase>(Property))
+			return true;
+		if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+			return ContainsObjectReference(ArrayProperty->Inner, EncounteredStructs);
+		if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+			return ContainsObjectReference(SetProperty->ElementProp, EncounteredStructs);
+		if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+			return ContainsObjectReference(MapProperty->KeyProp, EncounteredStructs) || ContainsObjectReference(MapProperty->ValueProp, EncounteredStructs);
+		if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+		{
+			bool bAlreadyEncountered = false;
+			EncounteredStructs.Add(StructProperty->Struct, &bAlreadyEncountered);
+			if (bAlreadyEncountered)
+				return false;
+
+			for (TFieldIterator<FProperty> Prop(StructProperty->Struct); Prop; ++Prop)
+			{
+				if (ContainsObjectReference(*Prop, EncounteredStructs))
+					return true;
+			}
+		}
+		return false;
+	}
+
+	uint32 HashStructLayout(const UStruct* Struct, TSet<const UStruct*>& EncounteredStructs)
+	{
+		uint32 Hash = FCrc::StrCrc32(*Struct->GetName());
+		EncounteredStructs.Add(Struct);
+
+		for (TFieldIterator<FProperty> Prop(Struct); Prop; ++Prop)
+		{
+			Hash = HashCombine(Hash, FCrc::StrCrc32(*Prop->GetName()));
+			Hash = HashCombine(Hash, FCrc::StrCrc32(*Prop->GetCPPType()));
+			Hash = HashCombine(Hash, GetTypeHash(Prop->GetOffset_ForInternal()));
+			Hash = HashCombine(Hash, GetTypeHash(Prop->ArrayDim));
+
+			// Layout of the structs inside (directly or in containers)
+			const FProperty* ValueProperty = *Prop;
+			if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(ValueProperty))
+				ValueProperty = ArrayProperty->Inner;
+			else if (const FSetProperty* SetProperty = CastField<FSetProperty>(ValueProperty))
+				ValueProperty = SetProperty->ElementProp;
+			else if (const FMapProperty* MapProperty = CastField<FMapProperty>(ValueProperty))
+				ValueProperty = MapProperty->ValueProp;
+
+			const FStructProperty* StructProperty = CastField<FStructProperty>(ValueProperty);
+			if (StructProperty && !EncounteredStructs.Contains(StructProperty->Struct))
+				Hash = HashCombine(Hash, HashStructLayout(StructProperty->Struct, EncounteredStructs));
+		}
+		return Hash;
+	}
+}
+
+FPropertySchemaCache& FPropertySchemaCache::Get()
+{
+	static FPropertySchemaCache Instance;
+	return Instance;
+}
+
+FPropertySchemaCache::FPropertySchemaCache()
+{
+	ObjectExportCallback.BindStatic(FCustomCallbacksDemoLocal::ObjectJsonCallback);
+
+	// Reflection data is not valid after hot-reload (and after unload of the module with the classes)
+	FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([this](EReloadCompleteReason)
+	{
+		Invalidate();
+	});
+	FModuleManager::Get().OnModulesChanged().AddLambda([this](FName, EModuleChangeReason Reason)
+	{
+		if (Reason == EModuleChangeReason::ModuleUnloaded)
+			Invalidate();
+	});
+	FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FPropertySchemaCache::OnPostGarbageCollect);
+}
+
+const FPropertySchema& FPropertySchemaCache::GetSchema(const UStruct* Struct)
+{
+	const FObjectKey StructKey(Struct);
+	{
+		FReadScopeLock ReadLock(SchemasLock);
+		if (const TUniquePtr<FPropertySchema>* Schema = Schemas.Find(StructKey))
+			return **Schema;
+	}
+
+	TUniquePtr<FPropertySchema> NewSchema = BuildSchema(Struct);
+
+	FWriteScopeLock WriteLock(SchemasLock);
+	// Another thread could build it meanwhile
+	TUniquePtr<FPropertySchema>& Schema = Schemas.FindOrAdd(StructKey);
+	if (!Schema)
+		Schema = MoveTemp(NewSchema);
+	return *Schema;
+}
+
+void FPropertySchemaCache::Invalidate()
+{
+	FWriteScopeLock WriteLock(SchemasLock);
+	Schemas.Empty();
+}
+
+void FPropertySchemaCache::OnPostGarbageCollect()
+{
+	FWriteScopeLock WriteLock(SchemasLock);
+	for (auto It = Schemas.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().ResolveObjectPtr())
+			It.RemoveCurrent();
+	}
+}
+
+TUniquePtr<FPropertySchema> FPropertySchemaCache::BuildSchema(const UStruct* Struct) const
+{
+	TUniquePtr<FPropertySchema> Schema = MakeUnique<FPropertySchema>();
+	Schema->Struct = Struct;
+
+	for (TFieldIterator<FProperty> Prop(Struct); Prop; ++Prop)
+	{
+		FCachedProperty& Cached = Schema->Properties.AddDefaulted_GetRef();
+		Cached.Property = *Prop;
+		Cached.ObjectFieldName = Prop->GetNameCPP();
+		Cached.StructFieldName = FJsonObjectConverter::StandardizeCase(Prop->GetName());
+		Cached.Offset = Prop->GetOffset_ForInternal();
+
+		TSet<const UStruct*> EncounteredStructs;
+		if (FPropertySchemaCacheLocal::ContainsObjectReference(*Prop, EncounteredStructs))
+			Cached.ExportCallback = &ObjectExportCallback;
+
+		Schema->PropertyIndexByName.Add(Prop->GetFName(), Schema->Properties.Num() - 1);
+	}
+
+	TSet<const UStruct*> EncounteredStructs;
+	Schema->SchemaHash = FPropertySchemaCacheLocal::HashStructLayout(Struct, EncounteredStructs);
+
+	return Schema;
+}
@@ -0,0 +1,72 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "JsonObjectConverter.h"
+#include "UObject/ObjectKey.h"
+
+// Cached reflection data of one property
+struct FCachedProperty
+{
+	FProperty* Property = nullptr;
+	// Name of the field in json of object (GetNameCPP) and of struct (FJsonObjectConverter::StandardizeCase)
+	FString ObjectFieldName;
+	FString StructFieldName;
+	// Offset of the value in the container
+	int32 Offset = 0;
+	// Pre-bound CustomExportCallback (ObjectJsonCallback). nullptr if the value can't contain object references,
+	// so FJsonObjectConverter does not call the delegate for every scalar inside
+	const FJsonObjectConverter::CustomExportCallback* ExportCallback = nullptr;
+
+	template <typename T = void>
+	T* GetValuePtr(void* Container) const { return reinterpret_cast<T*>(static_cast<uint8*>(Container) + Offset); }
+	template <typename T = void>
+	const T* GetValuePtr(const void* Container) const { return reinterpret_cast<const T*>(static_cast<const uint8*>(Container) + Offset); }
+};
+
+// Ordered property list of UClass/UStruct with hashed lookup by name
+struct FPropertySchema
+{
+	const UStruct* Struct = nullptr;
+	TArray<FCachedProperty> Properties;
+	TMap<FName, int32> PropertyIndexByName;
+	// Hash of names, types and offsets of the properties (including nested structs). Changes when the layout changes
+	uint32 SchemaHash = 0;
+
+	// Replacement of UStruct::FindPropertyByName. Names are compared case-insensitive, as FName
+	const FCachedProperty* FindProperty(const FString& InName) const
+	{
+		const FName Name(*InName, FNAME_Find);
+		const int32* Index = Name.IsNone() ? nullptr : PropertyIndexByName.Find(Name);
+		return Index ? &Properties[*Index] : nullptr;
+	}
+};
+
+/**
+ * Cache of property schemas keyed by UClass/UStruct. Schema is built once per class (thread-safe, bulk export uses it
+ * from worker threads) and dropped on hot-reload and on module unload. The key is FObjectKey, so a class collected by GC
+ * (e.g. blueprint class of an unloaded package) never matches a new class at the same address; its schema is dropped after GC.
+ */
+class FPropertySchemaCache
+{
+public:
+	static FPropertySchemaCache& Get();
+
+	const FPropertySchema& GetSchema(const UStruct* Struct);
+
+	void Invalidate();
+
+private:
+	// Drop the schemas of the collected classes and structs
+	void OnPostGarbageCollect();
+
+	FPropertySchemaCache();
+
+	TUniquePtr<FPropertySchema> BuildSchema(const UStruct* Struct) const;
+
+	FRWLock SchemasLock;
+	TMap<FObjectKey, TUniquePtr<FPropertySchema>> Schemas;
+
+	FJsonObjectConverter::CustomExportCallback ObjectExportCallback;
+};
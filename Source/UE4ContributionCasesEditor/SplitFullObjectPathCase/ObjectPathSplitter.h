@@ -0,0 +1,90 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StringView.h"
+
+// Parts of the textual object reference "Class'/Package/Path.Object:SubObject'" as slices of the original string
+struct FObjectPathView
+{
+	FStringView ClassName;
+	FStringView PackageName;
+	FStringView ObjectName;
+	FStringView SubObjectName;
+};
+
+namespace FObjectPathSplitter
+{
+	// Pointer to the first character equal to A or B in [Begin, End), or End.
+	// Characters are compared word-at-a-time: 4 UTF-16 characters per 64-bit word
+	inline const TCHAR* FindFirstOf(const TCHAR* Begin, const TCHAR* End, TCHAR A, TCHAR B)
+	{
+		const TCHAR* Cur = Begin;
+		if (sizeof(TCHAR) == 2)
+		{
+			constexpr uint64 LowBits = 0x0001000100010001ull;
+			constexpr uint64 HighBits = 0x8000800080008000ull;
+			const uint64 PatternA = LowBits * static_cast<uint16>(A);
+			const uint64 PatternB = LowBits * static_cast<uint16>(B);
+
+			for (; End - Cur >= 4; Cur += 4)
+			{
+				uint64 Word;
+				FMemory::Memcpy(&Word, Cur, sizeof(Word));
+
+				// Lane of XorA/XorB is zero where the character is equal to A/B. Borrows can only mark lanes
+				// above the really matched one, so the lowest marked lane is always the first match
+				const uint64 XorA = Word ^ PatternA;
+				const uint64 XorB = Word ^ PatternB;
+				const uint64 Matches = ((XorA - LowBits) & ~XorA & HighBits) | ((XorB - LowBits) & ~XorB & HighBits);
+				if (Matches != 0)
+				{
+#if PLATFORM_LITTLE_ENDIAN
+					return Cur + FMath::CountTrailingZeros64(Matches) / 16;
+#else
+					break;
+#endif
+				}
+			}
+		}
+
+		for (; Cur < End; ++Cur)
+		{
+			if (*Cur == A || *Cur == B)
+				return Cur;
+		}
+		return End;
+	}
+
+	// The same result as FCustomCallbacksDemoLocal::CustomSplitFullObjectPath, but without any allocation:
+	// the parts are views into InFullObjectPath
+	inline FObjectPathView Split(FStringView InFullObjectPath)
+	{
+		const TCHAR* Cur = InFullObjectPath.GetData();
+		const TCHAR* End = Cur + InFullObjectPath.Len();
+
+		// TrimStartAndEnd
+		while (Cur < End && FChar::IsWhitespace(*Cur))
+			++Cur;
+		while (End > Cur && FChar::IsWhitespace(*(End - 1)))
+			--End;
+
+		auto ExtractBeforeDelim = [&Cur, End](TCHAR Delim)
+		{
+			const TCHAR* Start = Cur;
+			Cur = FindFirstOf(Cur, End, Delim, TEXT('\''));
+			const FStringView Result(Start, static_cast<int32>(Cur - Start));
+			if (Cur < End)
+				++Cur;
+			return Result;
+		};
+
+		FObjectPathView Result;
+		Result.ClassName = ExtractBeforeDelim(TEXT(' '));
+		Result.PackageName = ExtractBeforeDelim(TEXT('.'));
+		Result.ObjectName = ExtractBeforeDelim(TEXT(':'));
+		Result.SubObjectName = ExtractBeforeDelim(TEXT('\''));
+		return Result;
+	}
+}
@@ -0,0 +1,276 @@
+#include "SplitFullObjectPathBenchmark.h"
+
+#include "ObjectPathSplitter.h"
+#include "TestsSplitFullObjectPathCommandlet.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "UE4ContributionCasesEditor/JsonObjectConverter/CustomJsonCallbacks.h"
+
+namespace FSplitFullObjectPathBenchmarkLocal
+{
+	// Allocations of the current thread while counting is enabled on it
+	struct FThreadAllocationCounters
+	{
+		bool bEnabled;
+		uint64 NumAllocations;
+		uint64 NumBytes;
+	};
+	static thread_local FThreadAllocationCounters ThreadAllocationCounters = { false, 0, 0 };
+
+	/**
+	 * Proxy of GMalloc which counts allocations of the threads with enabled counters.
+	 * It is installed once and never removed: swapping GMalloc back and forth while other threads allocate is not safe
+	 */
+	class FMallocCountingProxy : public FMalloc
+	{
+	public:
+		static void Install()
+		{
+			static FMallocCountingProxy* Instance = nullptr;
+			if (!Instance)
+			{
+				Instance = new FMallocCountingProxy(GMalloc);
+				GMalloc = Instance;
+			}
+		}
+
+		virtual void* Malloc(SIZE_T Size, uint32 Alignment) override
+		{
+			Count(Size);
+			return Inner->Malloc(Size, Alignment);
+		}
+
+		virtual void* Realloc(void* Ptr, SIZE_T NewSize, uint32 Alignment) override
+		{
+			Count(NewSize);
+			return Inner->Realloc(Ptr, NewSize, Alignment);
+		}
+
+		virtual void Free(void* Ptr) override
+		{
+			Inner->Free(Ptr);
+		}
+
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+		virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+		virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+		virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+		virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+		virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+
+	private:
+		explicit FMallocCountingProxy(FMalloc* InInner)
+			: Inner(InInner)
+		{
+		}
+
+		static void Count(SIZE_T Size)
+		{
+			FThreadAllocationCounters& Counters = ThreadAllocationCounters;
+			if (Counters.bEnabled)
+			{
+				++Counters.NumAllocations;
+				Counters.NumBytes += Size;
+			}
+		}
+
+		FMalloc* Inner;
+	};
+
+	struct FSplitterResult
+	{
+		FString Name;
+		double NsPerOp = 0.0;
+		double P50Ns = 0.0;
+		double P99Ns = 0.0;
+		double AllocationsPerCall = 0.0;
+		double BytesPerCall = 0.0;
+		uint64 Checksum = 0;
+	};
+
+	// Split function returns the summary length of the parts, so the compiler can't throw the call away
+	template <typename SplitFunctionType>
+	FSplitterResult RunSplitter(const FString& InName, const TArray<FString>& Corpus, const FSplitFullObjectPathBenchmarkSettings& Settings, SplitFunctionType SplitFunction)
+	{
+		FSplitterResult Result;
+		Result.Name = InName;
+
+		// Warm up (the first calls may allocate FName entries etc.)
+		for (const FString& Ref : Corpus)
+			Result.Checksum += SplitFunction(Ref);
+		Result.Checksum = 0;
+
+		// Throughput and allocations: the whole pass is timed at once, so the timer doesn't add to ns/op
+		FMallocCountingProxy::Install();
+		ThreadAllocationCounters = { true, 0, 0 };
+		uint64 TotalCycles = 0;
+		for (int32 Iteration = 0; Iteration < Settings.Iterations; ++Iteration)
+		{
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			for (const FString& Ref : Corpus)
+				Result.Checksum += SplitFunction(Ref);
+			TotalCycles += FPlatformTime::Cycles64() - StartCycles;
+		}
+		const FThreadAllocationCounters Counters = ThreadAllocationCounters;
+		ThreadAllocationCounters.bEnabled = false;
+
+		const double NumCalls = double(Settings.Iterations) * Corpus.Num();
+		Result.NsPerOp = FPlatformTime::ToSeconds64(TotalCycles) * 1e9 / NumCalls;
+		Result.AllocationsPerCall = Counters.NumAllocations / NumCalls;
+		Result.BytesPerCall = Counters.NumBytes / NumCalls;
+
+		// Latency: each sample is SampleSize calls (one call by default), the value is the time per call of the sample
+		const int32 SampleSize = Settings.SampleSize;
+		TArray<double> SamplesNs;
+		SamplesNs.Reserve(Settings.Iterations * (Corpus.Num() / SampleSize + 1));
+		uint64 LatencyChecksum = 0;
+		for (int32 Iteration = 0; Iteration < Settings.Iterations; ++Iteration)
+		{
+			for (int32 SampleStart = 0; SampleStart < Corpus.Num(); SampleStart += SampleSize)
+			{
+				const int32 SampleEnd = FMath::Min(SampleStart + SampleSize, Corpus.Num());
+				const uint64 StartCycles = FPlatformTime::Cycles64();
+				for (int32 Index = SampleStart; Index < SampleEnd; ++Index)
+					LatencyChecksum += SplitFunction(Corpus[Index]);
+				const uint64 SampleCycles = FPlatformTime::Cycles64() - StartCycles;
+				SamplesNs.Add(FPlatformTime::ToSeconds64(SampleCycles) * 1e9 / (SampleEnd - SampleStart));
+			}
+		}
+		ensure(LatencyChecksum == Result.Checksum);
+
+		SamplesNs.Sort();
+		if (SamplesNs.Num() > 0)
+		{
+			Result.P50Ns = SamplesNs[SamplesNs.Num() / 2];
+			Result.P99Ns = SamplesNs[FMath::Min(SamplesNs.Num() - 1, SamplesNs.Num() * 99 / 100)];
+		}
+		return Result;
+	}
+
+	int32 PartsLen(const FString& ClassName, const FString& PackageName, const FString& ObjectName, const FString& SubObjectName)
+	{
+		return ClassName.Len() + PackageName.Len() + ObjectName.Len() + SubObjectName.Len();
+	}
+}
+
+FSplitFullObjectPathBenchmarkSettings FSplitFullObjectPathBenchmarkSettings::FromParams(const FString& Params)
+{
+	FSplitFullObjectPathBenchmarkSettings Settings;
+	FParse::Value(*Params, TEXT("Count="), Settings.CorpusSize);
+	FParse::Value(*Params, TEXT("Iterations="), Settings.Iterations);
+	FParse::Value(*Params, TEXT("SampleSize="), Settings.SampleSize);
+	FParse::Value(*Params, TEXT("MaxDepth="), Settings.MaxSubObjectDepth);
+	FParse::Value(*Params, TEXT("Seed="), Settings.Seed);
+	Settings.CsvFilePath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SplitFullObjectPathBenchmark.csv"));
+	FParse::Value(*Params, TEXT("Csv="), Settings.CsvFilePath);
+	return Settings;
+}
+
+namespace FSplitFullObjectPathBenchmark
+{
+	TArray<FString> GenerateCorpus(const FSplitFullObjectPathBenchmarkSettings& Settings)
+	{
+		FRandomStream Random(Settings.Seed);
+
+		const TCHAR* ClassNames[] = { TEXT("SomeDataAsset"), TEXT("SomePrimaryDataAsset"), TEXT("FirstTypeForInstancing"), TEXT("SecondTypeForInstancing"), TEXT("Texture2D"), TEXT("StaticMesh") };
+		const TCHAR* Folders[] = { TEXT("ExamplesAssets"), TEXT("CustomDataAssets"), TEXT("Characters"), TEXT("Environment"), TEXT("Props"), TEXT("UI") };
+
+		TArray<FString> Corpus;
+		Corpus.Reserve(Settings.CorpusSize);
+		for (int32 Index = 0; Index < Settings.CorpusSize; ++Index)
+		{
+			const TCHAR* ClassName = ClassNames[Random.RandHelper(UE_ARRAY_COUNT(ClassNames))];
+			const int32 Kind = Random.RandHelper(4);
+			if (Kind == 0)
+			{
+				// Class-only path
+				Corpus.Add(FString::Printf(TEXT("Class'/Script/UE4ContributionCases.%s'"), ClassName));
+				continue;
+			}
+
+			FString PackagePath = TEXT("/Game");
+			const int32 NumFolders = 1 + Random.RandHelper(4);
+			for (int32 Folder = 0; Folder < NumFolders; ++Folder)
+				PackagePath += FString(TEXT("/")) + Folders[Random.RandHelper(UE_ARRAY_COUNT(Folders))];
+
+			const FString AssetName = FString::Printf(TEXT("DA_Asset_%d"), Index);
+			FString Ref = FString::Printf(TEXT("%s'%s/%s.%s"), ClassName, *PackagePath, *AssetName, *AssetName);
+			if (Kind >= 2)
+			{
+				// Path with subobject, or deeply nested subobject chain
+				Ref += FString::Printf(TEXT(":SecondTypeForInstancing_%d"), Random.RandHelper(16));
+				const int32 Depth = Kind == 3 ? 1 + Random.RandHelper(FMath::Max(Settings.MaxSubObjectDepth, 1)) : 0;
+				for (int32 Level = 0; Level < Depth; ++Level)
+					Ref += FString::Printf(TEXT(".FirstTypeForInstancing_%d"), Random.RandHelper(16));
+			}
+			Ref += TEXT("'");
+			Corpus.Add(MoveTemp(Ref));
+		}
+		return Corpus;
+	}
+
+	int32 Run(const FSplitFullObjectPathBenchmarkSettings& Settings)
+	{
+		using namespace FSplitFullObjectPathBenchmarkLocal;
+
+		if (Settings.CorpusSize < 1 || Settings.Iterations < 1 || Settings.SampleSize < 1)
+		{
+			UE_LOG(LogTestRef, Error, TEXT("-Count=, -Iterations= and -SampleSize= must be at least 1."));
+			return 1;
+		}
+
+		UE_LOG(LogTestRef, Display, TEXT("Benchmark: corpus %d references, %d iterations, sample %d calls."), Settings.CorpusSize, Settings.Iterations, Settings.SampleSize);
+		const TArray<FString> Corpus = GenerateCorpus(Settings);
+
+		TArray<FSplitterResult> Results;
+		Results.Add(RunSplitter(TEXT("FPackageName::SplitFullObjectPath"), Corpus, Settings, [](const FString& Ref)
+		{
+			FString ClassName, PackageName, ObjectName, SubObjectName;
+			FPackageName::SplitFullObjectPath(Ref, ClassName, PackageName, ObjectName, SubObjectName);
+			return PartsLen(ClassName, PackageName, ObjectName, SubObjectName);
+		}));
+		Results.Add(RunSplitter(TEXT("CustomSplitFullObjectPath"), Corpus, Settings, [](const FString& Ref)
+		{
+			FString ClassName, PackageName, ObjectName, SubObjectName;
+			FCustomCallbacksDemoLocal::CustomSplitFullObjectPath(Ref, ClassName, PackageName, ObjectName, SubObjectName);
+			return PartsLen(ClassName, PackageName, ObjectName, SubObjectName);
+		}));
+		Results.Add(RunSplitter(TEXT("FObjectPathSplitter::Split"), Corpus, Settings, [](const FString& Ref)
+		{
+			const FObjectPathView PathView = FObjectPathSplitter::Split(Ref);
+			return PathView.ClassName.Len() + PathView.PackageName.Len() + PathView.ObjectName.Len() + PathView.SubObjectName.Len();
+		}));
+
+		// Report
+		const FString EngineVersion = FEngineVersion::Current().ToString();
+		FString Csv;
+		if (!FPaths::FileExists(Settings.CsvFilePath))
+			Csv += TEXT("EngineVersion,Splitter,CorpusSize,Iterations,NsPerOp,P50Ns,P99Ns,AllocationsPerCall,BytesPerCall,SampleSize\n");
+
+		// With SampleSize > 1 the percentiles are of the batch average, not of a single call
+		const FString PercentileSuffix = Settings.SampleSize > 1 ? FString::Printf(TEXT(" (batch %d)"), Settings.SampleSize) : FString();
+		UE_LOG(LogTestRef, Display, TEXT("%-36s %10s %18s %18s %12s %12s"), TEXT("Splitter"), TEXT("ns/op"),
+			*(TEXT("p50 ns") + PercentileSuffix), *(TEXT("p99 ns") + PercentileSuffix), TEXT("allocs/call"), TEXT("bytes/call"));
+		for (const FSplitterResult& Result : Results)
+		{
+			UE_LOG(LogTestRef, Display, TEXT("%-36s %10.1f %18.1f %18.1f %12.2f %12.1f"), *Result.Name, Result.NsPerOp, Result.P50Ns, Result.P99Ns, Result.AllocationsPerCall, Result.BytesPerCall);
+			Csv += FString::Printf(TEXT("%s,%s,%d,%d,%.2f,%.2f,%.2f,%.3f,%.1f,%d\n"), *EngineVersion, *Result.Name, Corpus.Num(), Settings.Iterations,
+				Result.NsPerOp, Result.P50Ns, Result.P99Ns, Result.AllocationsPerCall, Result.BytesPerCall, Settings.SampleSize);
+		}
+
+		// The custom splitters must give the same parts
+		if (Results[1].Checksum != Results[2].Checksum)
+			UE_LOG(LogTestRef, Error, TEXT("CustomSplitFullObjectPath and FObjectPathSplitter::Split results differ."));
+
+		if (!FFileHelper::SaveStringToFile(Csv, *Settings.CsvFilePath, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append))
+		{
+			UE_LOG(LogTestRef, Error, TEXT("Unable to save file '%s'."), *Settings.CsvFilePath);
+			return 1;
+		}
+		UE_LOG(LogTestRef, Display, TEXT("Benchmark results appended to '%s'."), *Settings.CsvFilePath);
+
+		return Results[1].Checksum == Results[2].Checksum ? 0 : 1;
+	}
+}
@@ -0,0 +1,34 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Settings of the benchmark mode of UTestsSplitFullObjectPathCommandlet
+struct FSplitFullObjectPathBenchmarkSettings
+{
+	// Number of references in the synthetic corpus ("-Count=")
+	int32 CorpusSize = 100000;
+	// Number of passes over the corpus for each splitter ("-Iterations=")
+	int32 Iterations = 5;
+	// Number of calls timed together as one latency sample ("-SampleSize="). 1 - percentiles of single calls,
+	// more - percentiles of the batch average (less timer overhead, but not the latency of a call)
+	int32 SampleSize = 1;
+	// Maximum depth of nested sub objects chain ("-MaxDepth=")
+	int32 MaxSubObjectDepth = 4;
+	// Seed of the corpus generator ("-Seed="), the same seed gives the same corpus
+	int32 Seed = 7371;
+	// Results are appended to this CSV file ("-Csv="), so they can be compared across engine versions
+	FString CsvFilePath;
+
+	static FSplitFullObjectPathBenchmarkSettings FromParams(const FString& Params);
+};
+
+namespace FSplitFullObjectPathBenchmark
+{
+	// Mix of class-only paths, package paths, paths with subobjects and deeply nested subobject chains
+	TArray<FString> GenerateCorpus(const FSplitFullObjectPathBenchmarkSettings& Settings);
+
+	// Run FPackageName::SplitFullObjectPath and the custom splitters over the corpus, log the report and write CSV
+	int32 Run(const FSplitFullObjectPathBenchmarkSettings& Settings);
+}
@@ -0,0 +1,91 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ObjectPathSplitter.h"
+#include "SplitFullObjectPathBenchmark.h"
+#include "TestsSplitFullObjectPathCommandlet.generated.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogTestRef, Log, All);
+/**
+ * 
+ */
+UCLASS()
+class UE4CONTRIBUTIONCASESEDITOR_API UTestsSplitFullObjectPathCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+	
+public:
+	UTestsSplitFullObjectPathCommandlet(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+	{
+		LogToConsole = true;
+	}
+
+	void PrintTestResult(const FString& InRef)
+	{
+		FString ClassName;
+		FString PackagePath;
+		FString ObjectName;
+		FString SubObjectName;
+		FPackageName::SplitFullObjectPath(InRef, ClassName, PackagePath, ObjectName, SubObjectName);
+		UE_LOG(LogTestRef, Display, TEXT("Results:\nInString: '%s'\n\tOutClassName: '%s'\n\tOutPackageName: '%s'\n\tOutObjectName: '%s'\n\tOutSubObjectName: '%s'"), *InRef, *ClassName, *PackagePath, *ObjectName, *SubObjectName);
+	}
+
+	// Check FObjectPathSplitter (allocation-free splitter) against the expected parts
+	bool CheckObjectPathSplitter(const FString& InRef, const TArray<FString>& InExpected)
+	{
+		const FObjectPathView PathView = FObjectPathSplitter::Split(InRef);
+		const FStringView Parts[] = { PathView.ClassName, PathView.PackageName, PathView.ObjectName, PathView.SubObjectName };
+
+		bool bResult = true;
+		for (int32 i = 0; i < UE_ARRAY_COUNT(Parts); ++i)
+		{
+			const FString Part(Parts[i].Len(), Parts[i].GetData());
+			if (Part != InExpected[i])
+			{
+				UE_LOG(LogTestRef, Error, TEXT("FObjectPathSplitter::Split('%s'): part #%d is '%s', expected '%s'"), *InRef, i, *Part, *InExpected[i]);
+				bResult = false;
+			}
+		}
+		return bResult;
+	}
+	
+	virtual int32 Main(const FString& Params) override
+	{
+		UE_LOG(LogTestRef, Display, TEXT("UTestsSplitFullObjectPathCommandlet::Main => '%s'"), *Params);
+
+		// Throughput/latency of the splitters on a synthetic corpus
+		if (FParse::Param(*Params, TEXT("Benchmark")))
+			return FSplitFullObjectPathBenchmark::Run(FSplitFullObjectPathBenchmarkSettings::FromParams(Params));
+
+		// Links (References) known to me
+		TArray<FString> Refs
+		{
+			"Class'/Script/UE4ContributionCases.SomePrimaryDataAsset'",
+			"SomePrimaryDataAsset'/Game/ExamplesAssets/CustomDataAssets/DA_SomePrimaryDataAsset.DA_SomePrimaryDataAsset'",
+			"SomeDataAsset'/Game/ExamplesAssets/CustomDataAssets/DA_SomeDataAsset.DA_SomeDataAsset'",
+			"SecondTypeForInstancing'/Game/ExamplesAssets/CustomDataAssets/DA_SomeDataAsset.DA_SomeDataAsset:SecondTypeForInstancing_0'"
+		};
+
+		// Expected parts (class, package, object, sub object) of the links above
+		TArray<TArray<FString>> Expected
+		{
+			{ "Class", "/Script/UE4ContributionCases", "SomePrimaryDataAsset", "" },
+			{ "SomePrimaryDataAsset", "/Game/ExamplesAssets/CustomDataAssets/DA_SomePrimaryDataAsset", "DA_SomePrimaryDataAsset", "" },
+			{ "SomeDataAsset", "/Game/ExamplesAssets/CustomDataAssets/DA_SomeDataAsset", "DA_SomeDataAsset", "" },
+			{ "SecondTypeForInstancing", "/Game/ExamplesAssets/CustomDataAssets/DA_SomeDataAsset", "DA_SomeDataAsset", "SecondTypeForInstancing_0" }
+		};
+
+		bool bSplitterPassed = true;
+		for (int32 i = 0; i < Refs.Num(); ++i)
+		{
+			UE_LOG(LogTestRef, Display, TEXT("UTestsSplitFullObjectPathCommandlet::Main => Test # '%d'"), i);
+			PrintTestResult(Refs[i]);
+			bSplitterPassed &= CheckObjectPathSplitter(Refs[i], Expected[i]);
+		}
+		
+		return bSplitterPassed ? 0 : 1;
+	}	
+};
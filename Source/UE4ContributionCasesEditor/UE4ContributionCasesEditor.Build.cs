@@ -0,0 +1,22 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class UE4ContributionCasesEditor : ModuleRules
+{
+    public UE4ContributionCasesEditor(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+        PublicDependencyModuleNames.AddRange(new string[]
+        {
+            "Core", 
+            "CoreUObject", 
+            "Engine", 
+            "UE4ContributionCases"
+        });
+
+        // Commandlets, FileHelpers and PackageTools
+        PrivateDependencyModuleNames.AddRange(new string[] {"UnrealEd", "Json", "JsonUtilities", "AssetRegistry"});
+    }
+}
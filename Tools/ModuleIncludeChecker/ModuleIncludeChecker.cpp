@@ -0,0 +1,785 @@
+// Standalone checker of cross-module includes and module dependency cycles of an Unreal project.
+// Finds the case of Plugins/UBTinformerErrorExapmle before the build: a header of one module includes a UCLASS header
+// of a module which is not its dependency, and the compiler reports only "Cannot open include file: '*.generated.h'"
+// at the included header. See README.md for the build command and the options.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+	struct FInclude
+	{
+		std::string Path;
+		int Line = 0;
+	};
+
+	// Parsed data of one source file, cached by content hash
+	struct FSourceFile
+	{
+		std::string RelativePath;
+		int64_t ModifiedTime = 0;
+		uint64_t Size = 0;
+		uint64_t Hash = 0;
+		// The file declares UCLASS/USTRUCT/UENUM/UINTERFACE or includes its "*.generated.h"
+		bool bReflected = false;
+		std::vector<FInclude> Includes;
+		bool bFromCache = false;
+		int ModuleIndex = -1;
+	};
+
+	enum class EDependencyKind
+	{
+		Public,
+		Private,
+		IncludePath,
+	};
+
+	struct FDependency
+	{
+		std::string ModuleName;
+		EDependencyKind Kind = EDependencyKind::Public;
+		int Line = 0;
+	};
+
+	struct FModule
+	{
+		std::string Name;
+		fs::path Directory;
+		fs::path BuildFile;
+		std::vector<FDependency> Dependencies;
+	};
+
+	// Edge of the module graph with the place which creates it
+	struct FEdge
+	{
+		int From = -1;
+		int To = -1;
+		std::string File;
+		int Line = 0;
+		std::string Reason;
+	};
+
+	uint64_t HashBytes(const std::string& Data)
+	{
+		// FNV-1a
+		uint64_t Hash = 14695981039346656037ull;
+		for (const unsigned char Char : Data)
+		{
+			Hash ^= Char;
+			Hash *= 1099511628211ull;
+		}
+		return Hash;
+	}
+
+	bool ReadFile(const fs::path& Path, std::string& OutData)
+	{
+		std::ifstream Stream(Path, std::ios::binary);
+		if (!Stream)
+			return false;
+		std::ostringstream Buffer;
+		Buffer << Stream.rdbuf();
+		OutData = Buffer.str();
+		return true;
+	}
+
+	// Comments and string contents are replaced by spaces, new lines are kept (so line numbers stay valid).
+	// Quoted include paths are kept: a string right after "#include" is not blanked
+	std::string StripComments(const std::string& Source)
+	{
+		std::string Result = Source;
+		enum class EState { Code, LineComment, BlockComment, String, Char } State = EState::Code;
+		size_t LineStart = 0;
+		for (size_t Index = 0; Index < Result.size(); ++Index)
+		{
+			const char Char = Result[Index];
+			const char Next = Index + 1 < Result.size() ? Result[Index + 1] : '\0';
+			if (Char == '\n')
+				LineStart = Index + 1;
+
+			switch (State)
+			{
+			case EState::Code:
+				if (Char == '/' && Next == '/')
+				{
+					State = EState::LineComment;
+					Result[Index] = ' ';
+				}
+				else if (Char == '/' && Next == '*')
+				{
+					State = EState::BlockComment;
+					Result[Index] = ' ';
+					Result[++Index] = ' ';
+				}
+				else if (Char == '"')
+				{
+					const std::string LineHead = Result.substr(LineStart, Index - LineStart);
+					if (LineHead.find("include") == std::string::npos)
+						State = EState::String;
+				}
+				else if (Char == '\'')
+				{
+					State = EState::Char;
+				}
+				break;
+			case EState::LineComment:
+				if (Char == '\n')
+					State = EState::Code;
+				else
+					Result[Index] = ' ';
+				break;
+			case EState::BlockComment:
+				if (Char == '*' && Next == '/')
+				{
+					Result[Index] = ' ';
+					Result[++Index] = ' ';
+					State = EState::Code;
+				}
+				else if (Char != '\n')
+				{
+					Result[Index] = ' ';
+				}
+				break;
+			case EState::String:
+			case EState::Char:
+				if (Char == '\\')
+				{
+					if (Next != '\n')
+						Result[++Index] = ' ';
+				}
+				else if ((State == EState::String && Char == '"') || (State == EState::Char && Char == '\''))
+				{
+					State = EState::Code;
+				}
+				else if (Char == '\n')
+				{
+					State = EState::Code;
+				}
+				break;
+			}
+		}
+		return Result;
+	}
+
+	bool IsIdentifierChar(char Char)
+	{
+		return (Char >= 'a' && Char <= 'z') || (Char >= 'A' && Char <= 'Z') || (Char >= '0' && Char <= '9') || Char == '_';
+	}
+
+	// Position of the identifier as a whole token, or npos
+	size_t FindToken(const std::string& Text, const std::string& Token, size_t From = 0)
+	{
+		for (size_t Pos = Text.find(Token, From); Pos != std::string::npos; Pos = Text.find(Token, Pos + 1))
+		{
+			const bool bStart = Pos == 0 || !IsIdentifierChar(Text[Pos - 1]);
+			const bool bEnd = Pos + Token.size() >= Text.size() || !IsIdentifierChar(Text[Pos + Token.size()]);
+			if (bStart && bEnd)
+				return Pos;
+		}
+		return std::string::npos;
+	}
+
+	void ParseSource(const std::string& Source, FSourceFile& OutFile)
+	{
+		const std::string Code = StripComments(Source);
+		OutFile.Includes.clear();
+		OutFile.bReflected = false;
+
+		std::istringstream Lines(Code);
+		std::string Line;
+		int LineNumber = 0;
+		while (std::getline(Lines, Line))
+		{
+			++LineNumber;
+			size_t Pos = Line.find_first_not_of(" \t");
+			if (Pos == std::string::npos || Line[Pos] != '#')
+				continue;
+			Pos = Line.find_first_not_of(" \t", Pos + 1);
+			if (Pos == std::string::npos || Line.compare(Pos, 7, "include") != 0)
+				continue;
+			Pos = Line.find_first_of("\"<", Pos + 7);
+			if (Pos == std::string::npos)
+				continue;
+			const size_t End = Line.find(Line[Pos] == '"' ? '"' : '>', Pos + 1);
+			if (End == std::string::npos)
+				continue;
+
+			FInclude Include;
+			Include.Path = Line.substr(Pos + 1, End - Pos - 1);
+			Include.Line = LineNumber;
+			if (Include.Path.size() > 12 && Include.Path.compare(Include.Path.size() - 12, 12, ".generated.h") == 0)
+				OutFile.bReflected = true;
+			OutFile.Includes.push_back(std::move(Include));
+		}
+
+		for (const std::string Macro : {"UCLASS", "USTRUCT", "UENUM", "UINTERFACE"})
+		{
+			for (size_t Pos = FindToken(Code, Macro); Pos != std::string::npos && !OutFile.bReflected; Pos = FindToken(Code, Macro, Pos + 1))
+			{
+				const size_t Next = Code.find_first_not_of(" \t", Pos + Macro.size());
+				OutFile.bReflected = Next != std::string::npos && Code[Next] == '(';
+			}
+		}
+	}
+
+	int LineOfOffset(const std::string& Text, size_t Offset)
+	{
+		return 1 + static_cast<int>(std::count(Text.begin(), Text.begin() + static_cast<std::ptrdiff_t>(Offset), '\n'));
+	}
+
+	// Module names from "XxxModuleNames.AddRange(new string[] { "A", "B" })" and "XxxModuleNames.Add("A")"
+	void ParseBuildFile(const std::string& Source, FModule& OutModule)
+	{
+		const std::string Code = StripComments(Source);
+		const std::pair<const char*, EDependencyKind> Lists[] = {
+			{"PublicDependencyModuleNames", EDependencyKind::Public},
+			{"PrivateDependencyModuleNames", EDependencyKind::Private},
+			{"PublicIncludePathModuleNames", EDependencyKind::IncludePath},
+			{"PrivateIncludePathModuleNames", EDependencyKind::IncludePath},
+		};
+		for (const auto& List : Lists)
+		{
+			for (size_t Pos = FindToken(Code, List.first); Pos != std::string::npos; Pos = FindToken(Code, List.first, Pos + 1))
+			{
+				// Arguments of the call: from '(' to the matching ')'
+				size_t Open = Code.find_first_not_of(" \t\r\n", Pos + std::strlen(List.first));
+				if (Open == std::string::npos || Code[Open] != '.')
+					continue;
+				Open = Code.find('(', Open);
+				if (Open == std::string::npos)
+					continue;
+				int Depth = 0;
+				size_t Close = Open;
+				for (; Close < Code.size(); ++Close)
+				{
+					if (Code[Close] == '(')
+						++Depth;
+					else if (Code[Close] == ')' && --Depth == 0)
+						break;
+				}
+
+				for (size_t Quote = Code.find('"', Open); Quote != std::string::npos && Quote < Close; Quote = Code.find('"', Quote + 1))
+				{
+					const size_t EndQuote = Code.find('"', Quote + 1);
+					if (EndQuote == std::string::npos || EndQuote > Close)
+						break;
+					OutModule.Dependencies.push_back({Code.substr(Quote + 1, EndQuote - Quote - 1), List.second, LineOfOffset(Code, Quote)});
+					Quote = EndQuote;
+				}
+			}
+		}
+	}
+
+	std::string ToGenericString(const fs::path& Path)
+	{
+		return Path.lexically_normal().generic_string();
+	}
+
+	bool IsSkippedDirectory(const fs::path& Path)
+	{
+		static const std::set<std::string> Skipped = {"Intermediate", "Binaries", "Saved", "DerivedDataCache", "Content", ".git", ".vs", ".idea", "_gate_build"};
+		return Skipped.count(Path.filename().string()) > 0;
+	}
+
+	bool IsSourceFile(const fs::path& Path)
+	{
+		static const std::set<std::string> Extensions = {".h", ".hpp", ".inl", ".cpp", ".c", ".cc"};
+		return Extensions.count(Path.extension().string()) > 0;
+	}
+
+	int64_t GetModifiedTime(const fs::path& Path)
+	{
+		std::error_code Error;
+		const auto Time = fs::last_write_time(Path, Error);
+		return Error ? 0 : static_cast<int64_t>(Time.time_since_epoch().count());
+	}
+
+	// Cache: one line per file "path \t mtime \t size \t hash \t reflected \t include:line|include:line..."
+	std::unordered_map<std::string, FSourceFile> LoadCache(const fs::path& CachePath)
+	{
+		std::unordered_map<std::string, FSourceFile> Cache;
+		std::ifstream Stream(CachePath);
+		std::string Line;
+		if (!std::getline(Stream, Line) || Line != "ModuleIncludeChecker 1")
+			return Cache;
+
+		while (std::getline(Stream, Line))
+		{
+			std::istringstream Fields(Line);
+			FSourceFile File;
+			std::string Reflected;
+			std::string Includes;
+			if (!std::getline(Fields, File.RelativePath, '\t'))
+				continue;
+			Fields >> File.ModifiedTime >> File.Size >> File.Hash >> Reflected;
+			Fields.ignore(1);
+			std::getline(Fields, Includes);
+			File.bReflected = Reflected == "1";
+
+			std::istringstream IncludeList(Includes);
+			std::string Item;
+			while (std::getline(IncludeList, Item, '|'))
+			{
+				const size_t Colon = Item.rfind(':');
+				if (Colon != std::string::npos)
+					File.Includes.push_back({Item.substr(0, Colon), std::atoi(Item.c_str() + Colon + 1)});
+			}
+			Cache.emplace(File.RelativePath, std::move(File));
+		}
+		return Cache;
+	}
+
+	void SaveCache(const fs::path& CachePath, const std::vector<FSourceFile>& Files)
+	{
+		std::error_code Error;
+		fs::create_directories(CachePath.parent_path(), Error);
+		std::ofstream Stream(CachePath, std::ios::trunc);
+		Stream << "ModuleIncludeChecker 1\n";
+		for (const FSourceFile& File : Files)
+		{
+			Stream << File.RelativePath << '\t' << File.ModifiedTime << '\t' << File.Size << '\t' << File.Hash << '\t' << (File.bReflected ? 1 : 0) << '\t';
+			for (size_t Index = 0; Index < File.Includes.size(); ++Index)
+				Stream << (Index ? "|" : "") << File.Includes[Index].Path << ':' << File.Includes[Index].Line;
+			Stream << '\n';
+		}
+	}
+
+	// Strongly connected components (Tarjan), iterative so deep graphs don't overflow the stack
+	std::vector<std::vector<int>> FindCycles(int NumNodes, const std::vector<std::vector<int>>& Adjacency)
+	{
+		std::vector<int> Index(NumNodes, -1), LowLink(NumNodes, 0), Stack;
+		std::vector<bool> bOnStack(NumNodes, false);
+		std::vector<std::vector<int>> Components;
+		int NextIndex = 0;
+
+		for (int Root = 0; Root < NumNodes; ++Root)
+		{
+			if (Index[Root] != -1)
+				continue;
+
+			std::vector<std::pair<int, size_t>> CallStack = {{Root, 0}};
+			Index[Root] = LowLink[Root] = NextIndex++;
+			Stack.push_back(Root);
+			bOnStack[Root] = true;
+			while (!CallStack.empty())
+			{
+				auto& [Node, EdgeIndex] = CallStack.back();
+				if (EdgeIndex < Adjacency[Node].size())
+				{
+					const int Next = Adjacency[Node][EdgeIndex++];
+					if (Index[Next] == -1)
+					{
+						Index[Next] = LowLink[Next] = NextIndex++;
+						Stack.push_back(Next);
+						bOnStack[Next] = true;
+						CallStack.push_back({Next, 0});
+					}
+					else if (bOnStack[Next])
+					{
+						LowLink[Node] = std::min(LowLink[Node], Index[Next]);
+					}
+					continue;
+				}
+
+				const int Finished = Node;
+				CallStack.pop_back();
+				if (!CallStack.empty())
+					LowLink[CallStack.back().first] = std::min(LowLink[CallStack.back().first], LowLink[Finished]);
+
+				if (LowLink[Finished] == Index[Finished])
+				{
+					std::vector<int> Component;
+					int Member;
+					do
+					{
+						Member = Stack.back();
+						Stack.pop_back();
+						bOnStack[Member] = false;
+						Component.push_back(Member);
+					} while (Member != Finished);
+
+					const bool bSelfLoop = std::find(Adjacency[Finished].begin(), Adjacency[Finished].end(), Finished) != Adjacency[Finished].end();
+					if (Component.size() > 1 || bSelfLoop)
+						Components.push_back(std::move(Component));
+				}
+			}
+		}
+		return Components;
+	}
+
+	// One simple cycle inside the component (breadth-first path back to the start)
+	std::vector<int> ExtractCycle(const std::vector<int>& Component, const std::vector<std::vector<int>>& Adjacency)
+	{
+		const std::unordered_set<int> Members(Component.begin(), Component.end());
+		const int Start = *std::min_element(Component.begin(), Component.end());
+		std::unordered_map<int, int> Parent;
+		std::vector<int> Queue = {Start};
+		for (size_t Head = 0; Head < Queue.size(); ++Head)
+		{
+			const int Node = Queue[Head];
+			for (const int Next : Adjacency[Node])
+			{
+				if (!Members.count(Next))
+					continue;
+				if (Next == Start)
+				{
+					std::vector<int> Cycle = {Start};
+					for (int Back = Node; Back != Start; Back = Parent[Back])
+						Cycle.insert(Cycle.begin() + 1, Back);
+					Cycle.push_back(Start);
+					return Cycle;
+				}
+				if (!Parent.count(Next))
+				{
+					Parent[Next] = Node;
+					Queue.push_back(Next);
+				}
+			}
+		}
+		return {Start, Start};
+	}
+
+	void PrintUsage()
+	{
+		std::printf("Usage: ModuleIncludeChecker <ProjectDir> [-cache=<file>] [-jobs=<N>] [-nocache]\n"
+			"Checks cross-module includes of the *.Build.cs modules under ProjectDir and module dependency cycles.\n");
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const auto StartTime = std::chrono::steady_clock::now();
+
+	if (argc < 2 || std::string(argv[1]) == "-help" || std::string(argv[1]) == "--help")
+	{
+		PrintUsage();
+		return argc < 2 ? 2 : 0;
+	}
+
+	const fs::path RootDir = fs::absolute(argv[1]).lexically_normal();
+	fs::path CachePath = RootDir / "Saved" / "ModuleIncludeChecker.cache";
+	unsigned NumJobs = std::max(1u, std::thread::hardware_concurrency());
+	bool bUseCache = true;
+	for (int Arg = 2; Arg < argc; ++Arg)
+	{
+		const std::string Value = argv[Arg];
+		if (Value.rfind("-cache=", 0) == 0)
+			CachePath = Value.substr(7);
+		else if (Value.rfind("-jobs=", 0) == 0)
+			NumJobs = std::max(1, std::atoi(Value.c_str() + 6));
+		else if (Value == "-nocache")
+			bUseCache = false;
+		else
+		{
+			PrintUsage();
+			return 2;
+		}
+	}
+
+	// Modules: directories of the *.Build.cs files
+	std::vector<FModule> Modules;
+	std::error_code Error;
+	for (auto It = fs::recursive_directory_iterator(RootDir, fs::directory_options::skip_permission_denied, Error); It != fs::recursive_directory_iterator(); It.increment(Error))
+	{
+		if (Error)
+			break;
+		if (It->is_directory() && IsSkippedDirectory(It->path()))
+		{
+			It.disable_recursion_pending();
+			continue;
+		}
+
+		const std::string FileName = It->path().filename().string();
+		const std::string Suffix = ".Build.cs";
+		if (!It->is_regular_file() || FileName.size() <= Suffix.size() || FileName.compare(FileName.size() - Suffix.size(), Suffix.size(), Suffix) != 0)
+			continue;
+
+		FModule Module;
+		Module.Name = FileName.substr(0, FileName.size() - Suffix.size());
+		Module.Directory = It->path().parent_path();
+		Module.BuildFile = It->path();
+		std::string BuildSource;
+		if (ReadFile(Module.BuildFile, BuildSource))
+			ParseBuildFile(BuildSource, Module);
+		Modules.push_back(std::move(Module));
+	}
+	if (Modules.empty())
+	{
+		std::fprintf(stderr, "No *.Build.cs found under '%s'.\n", RootDir.string().c_str());
+		return 2;
+	}
+
+	std::unordered_map<std::string, int> ModuleIndexByName;
+	for (int Index = 0; Index < static_cast<int>(Modules.size()); ++Index)
+		ModuleIndexByName[Modules[Index].Name] = Index;
+
+	// Source files of the modules, a file belongs to the innermost module directory
+	std::vector<FSourceFile> Files;
+	std::unordered_map<std::string, int> FileIndexByPath;
+	for (int ModuleIndex = 0; ModuleIndex < static_cast<int>(Modules.size()); ++ModuleIndex)
+	{
+		for (auto It = fs::recursive_directory_iterator(Modules[ModuleIndex].Directory, fs::directory_options::skip_permission_denied, Error); It != fs::recursive_directory_iterator(); It.increment(Error))
+		{
+			if (Error)
+				break;
+			if (It->is_directory() && IsSkippedDirectory(It->path()))
+			{
+				It.disable_recursion_pending();
+				continue;
+			}
+			if (!It->is_regular_file() || !IsSourceFile(It->path()))
+				continue;
+
+			const std::string RelativePath = ToGenericString(fs::relative(It->path(), RootDir));
+			const auto Existing = FileIndexByPath.find(RelativePath);
+			if (Existing != FileIndexByPath.end())
+			{
+				// Nested module: the deeper directory wins
+				FSourceFile& File = Files[Existing->second];
+				if (Modules[ModuleIndex].Directory.string().size() > Modules[File.ModuleIndex].Directory.string().size())
+					File.ModuleIndex = ModuleIndex;
+				continue;
+			}
+
+			FSourceFile File;
+			File.RelativePath = RelativePath;
+			File.ModuleIndex = ModuleIndex;
+			File.Size = static_cast<uint64_t>(It->file_size(Error));
+			File.ModifiedTime = GetModifiedTime(It->path());
+			FileIndexByPath.emplace(RelativePath, static_cast<int>(Files.size()));
+			Files.push_back(std::move(File));
+		}
+	}
+
+	// Parse in parallel: unchanged time and size - cached data without reading, otherwise the content hash decides
+	const std::unordered_map<std::string, FSourceFile> Cache = bUseCache ? LoadCache(CachePath) : std::unordered_map<std::string, FSourceFile>();
+	std::atomic<size_t> NextFile(0);
+	std::atomic<int> NumParsed(0);
+	auto Worker = [&]()
+	{
+		for (size_t Index = NextFile++; Index < Files.size(); Index = NextFile++)
+		{
+			FSourceFile& File = Files[Index];
+			const auto Cached = Cache.find(File.RelativePath);
+			if (Cached != Cache.end() && Cached->second.ModifiedTime == File.ModifiedTime && Cached->second.Size == File.Size)
+			{
+				File.Hash = Cached->second.Hash;
+				File.bReflected = Cached->second.bReflected;
+				File.Includes = Cached->second.Includes;
+				File.bFromCache = true;
+				continue;
+			}
+
+			std::string Source;
+			if (!ReadFile(RootDir / File.RelativePath, Source))
+				continue;
+			File.Hash = HashBytes(Source);
+			if (Cached != Cache.end() && Cached->second.Hash == File.Hash)
+			{
+				File.bReflected = Cached->second.bReflected;
+				File.Includes = Cached->second.Includes;
+				File.bFromCache = true;
+				continue;
+			}
+
+			ParseSource(Source, File);
+			++NumParsed;
+		}
+	};
+	std::vector<std::thread> Threads;
+	for (unsigned Job = 1; Job < std::min<size_t>(NumJobs, Files.size()); ++Job)
+		Threads.emplace_back(Worker);
+	Worker();
+	for (std::thread& Thread : Threads)
+		Thread.join();
+
+	if (bUseCache && (NumParsed > 0 || Cache.size() != Files.size() || std::any_of(Files.begin(), Files.end(), [](const FSourceFile& File) { return !File.bFromCache; })))
+		SaveCache(CachePath, Files);
+	else if (bUseCache)
+	{
+		// Touched files with the same content: keep the new times, so the next run doesn't read them again
+		bool bTimesChanged = false;
+		for (const FSourceFile& File : Files)
+			bTimesChanged |= Cache.at(File.RelativePath).ModifiedTime != File.ModifiedTime;
+		if (bTimesChanged)
+			SaveCache(CachePath, Files);
+	}
+
+	// Modules visible to each module: own dependencies plus public dependencies of them (transitively)
+	const int NumModules = static_cast<int>(Modules.size());
+	std::vector<std::vector<int>> PublicDependencies(NumModules);
+	for (int Index = 0; Index < NumModules; ++Index)
+	{
+		for (const FDependency& Dependency : Modules[Index].Dependencies)
+		{
+			const auto Target = ModuleIndexByName.find(Dependency.ModuleName);
+			if (Target != ModuleIndexByName.end() && Dependency.Kind != EDependencyKind::Private)
+				PublicDependencies[Index].push_back(Target->second);
+		}
+	}
+	std::vector<std::vector<bool>> bVisible(NumModules, std::vector<bool>(NumModules, false));
+	for (int Index = 0; Index < NumModules; ++Index)
+	{
+		std::vector<int> Queue = {Index};
+		bVisible[Index][Index] = true;
+		for (const FDependency& Dependency : Modules[Index].Dependencies)
+		{
+			const auto Target = ModuleIndexByName.find(Dependency.ModuleName);
+			if (Target != ModuleIndexByName.end() && !bVisible[Index][Target->second])
+			{
+				bVisible[Index][Target->second] = true;
+				Queue.push_back(Target->second);
+			}
+		}
+		for (size_t Head = 1; Head < Queue.size(); ++Head)
+		{
+			for (const int Next : PublicDependencies[Queue[Head]])
+			{
+				if (!bVisible[Index][Next])
+				{
+					bVisible[Index][Next] = true;
+					Queue.push_back(Next);
+				}
+			}
+		}
+	}
+
+	// Include search roots of each module: its directory, Public/Classes/Private, and the Source directory above it
+	std::vector<std::vector<fs::path>> SearchRoots(NumModules);
+	for (int Index = 0; Index < NumModules; ++Index)
+	{
+		const fs::path Relative = fs::relative(Modules[Index].Directory, RootDir);
+		for (const char* SubDirectory : {"", "Public", "Classes", "Private"})
+			SearchRoots[Index].push_back(Relative / SubDirectory);
+		SearchRoots[Index].push_back(Relative.parent_path());
+	}
+
+	auto ResolveInclude = [&](const FSourceFile& File, const std::string& IncludePath) -> int
+	{
+		auto TryPath = [&](const fs::path& Candidate) -> int
+		{
+			const auto Found = FileIndexByPath.find(ToGenericString(Candidate));
+			return Found != FileIndexByPath.end() ? Found->second : -1;
+		};
+
+		int Found = TryPath(fs::path(File.RelativePath).parent_path() / IncludePath);
+		for (const fs::path& Root : SearchRoots[File.ModuleIndex])
+			Found = Found >= 0 ? Found : TryPath(Root / IncludePath);
+		for (int Index = 0; Index < NumModules && Found < 0; ++Index)
+		{
+			for (const fs::path& Root : SearchRoots[Index])
+				Found = Found >= 0 ? Found : TryPath(Root / IncludePath);
+		}
+		return Found;
+	};
+
+	// Module graph: Build.cs dependencies and cross-module includes
+	std::vector<FEdge> Edges;
+	std::map<std::pair<int, int>, size_t> EdgeByModules;
+	auto AddEdge = [&](FEdge Edge)
+	{
+		if (EdgeByModules.emplace(std::make_pair(Edge.From, Edge.To), Edges.size()).second)
+			Edges.push_back(std::move(Edge));
+	};
+	for (int Index = 0; Index < NumModules; ++Index)
+	{
+		for (const FDependency& Dependency : Modules[Index].Dependencies)
+		{
+			const auto Target = ModuleIndexByName.find(Dependency.ModuleName);
+			if (Target == ModuleIndexByName.end() || Dependency.Kind == EDependencyKind::IncludePath)
+				continue;
+			const char* ListName = Dependency.Kind == EDependencyKind::Public ? "PublicDependencyModuleNames" : "PrivateDependencyModuleNames";
+			AddEdge({Index, Target->second, Modules[Index].BuildFile.string(), Dependency.Line, std::string("\"") + Dependency.ModuleName + "\" in " + ListName});
+		}
+	}
+
+	int NumErrors = 0;
+	int NumWarnings = 0;
+	std::vector<const FSourceFile*> SortedFiles;
+	for (const FSourceFile& File : Files)
+		SortedFiles.push_back(&File);
+	std::sort(SortedFiles.begin(), SortedFiles.end(), [](const FSourceFile* A, const FSourceFile* B) { return A->RelativePath < B->RelativePath; });
+
+	for (const FSourceFile* File : SortedFiles)
+	{
+		const FModule& Module = Modules[File->ModuleIndex];
+		for (const FInclude& Include : File->Includes)
+		{
+			const int Target = ResolveInclude(*File, Include.Path);
+			if (Target < 0 || Files[Target].ModuleIndex == File->ModuleIndex)
+				continue;
+
+			const FSourceFile& TargetFile = Files[Target];
+			const FModule& TargetModule = Modules[TargetFile.ModuleIndex];
+			const std::string Location = (RootDir / File->RelativePath).string() + "(" + std::to_string(Include.Line) + ")";
+			AddEdge({File->ModuleIndex, TargetFile.ModuleIndex, (RootDir / File->RelativePath).string(), Include.Line, "#include \"" + Include.Path + "\""});
+
+			if (!bVisible[File->ModuleIndex][TargetFile.ModuleIndex])
+			{
+				if (TargetFile.bReflected)
+				{
+					++NumErrors;
+					std::printf("%s: error: #include \"%s\" is a reflected (UCLASS) header of module '%s', which is not a dependency of '%s'. "
+						"The compiler will only report \"Cannot open include file: '%s.generated.h'\" in the included header. "
+						"Remove the include or add '%s' to %s.\n",
+						Location.c_str(), Include.Path.c_str(), TargetModule.Name.c_str(), Module.Name.c_str(), fs::path(TargetFile.RelativePath).stem().string().c_str(),
+						TargetModule.Name.c_str(), Module.BuildFile.filename().string().c_str());
+				}
+				else
+				{
+					++NumWarnings;
+					std::printf("%s: warning: #include \"%s\" is a header of module '%s', which is not a dependency of '%s'.\n",
+						Location.c_str(), Include.Path.c_str(), TargetModule.Name.c_str(), Module.Name.c_str());
+				}
+			}
+			else if (TargetFile.RelativePath.find("/Private/") != std::string::npos)
+			{
+				++NumWarnings;
+				std::printf("%s: warning: #include \"%s\" is a private header of module '%s'.\n", Location.c_str(), Include.Path.c_str(), TargetModule.Name.c_str());
+			}
+		}
+	}
+
+	// Cycles of the module graph, each with the places which create its edges
+	std::vector<std::vector<int>> Adjacency(NumModules);
+	for (const FEdge& Edge : Edges)
+		Adjacency[Edge.From].push_back(Edge.To);
+	for (const std::vector<int>& Component : FindCycles(NumModules, Adjacency))
+	{
+		const std::vector<int> Cycle = ExtractCycle(Component, Adjacency);
+		std::string Chain;
+		for (size_t Index = 0; Index < Cycle.size(); ++Index)
+			Chain += (Index ? " -> " : "") + Modules[Cycle[Index]].Name;
+
+		++NumErrors;
+		const FEdge& FirstEdge = Edges[EdgeByModules.at({Cycle[0], Cycle[1]})];
+		std::printf("%s(%d): error: module dependency cycle %s\n", FirstEdge.File.c_str(), FirstEdge.Line, Chain.c_str());
+		for (size_t Index = 0; Index + 1 < Cycle.size(); ++Index)
+		{
+			const FEdge& Edge = Edges[EdgeByModules.at({Cycle[Index], Cycle[Index + 1]})];
+			std::printf("%s(%d): note: %s -> %s by %s\n", Edge.File.c_str(), Edge.Line, Modules[Edge.From].Name.c_str(), Modules[Edge.To].Name.c_str(), Edge.Reason.c_str());
+		}
+	}
+
+	const auto Elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - StartTime).count();
+	std::printf("%zu modules, %zu files (%d parsed, %zu from cache): %d error(s), %d warning(s) in %.1f ms\n",
+		Modules.size(), Files.size(), NumParsed.load(), Files.size() - NumParsed.load(), NumErrors, NumWarnings, Elapsed / 1000.0);
+	return NumErrors > 0 ? 1 : 0;
+}